@@ -0,0 +1,757 @@
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fmt/core.h>
+#include <functional>
+#include <new>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "Context.hpp"
+#include "JSON/Document.hpp"
+#include "JSON/Lexer.hpp"
+#include "JSON/Token.hpp"
+#include "Program.hpp"
+#include "Reader.hpp"
+#include "Schema.hpp"
+#include "Session.hpp"
+
+// Benchmarks of the native hot paths. Every result is printed as one JSON
+// object per line, so two runs can be diffed or loaded as NDJSON. Inputs
+// are generated from a fixed seed and are the same on every run.
+//
+//     blueprint_bench [filter] [plugins]
+//     blueprint_bench --schema <input> <path>
+//
+// Only benchmarks whose name contains the filter are run. Inputs with a
+// validator generated ahead of time in the plugins directory, named after
+// the input as bench-records-10k.so, are also measured through it. The
+// second form writes the schema of an input, to generate one from.
+//
+// Batches and NDJSON are measured at 1, 2, 4 and one thread per core, and
+// also report records per second.
+
+// Allocations made through operator new since the start of the process
+static std::size_t allocations = 0;
+
+void *operator new(std::size_t size)
+{
+    ++allocations;
+    if (void *pointer = std::malloc(size == 0 ? 1 : size)) {
+        return pointer;
+    }
+
+    throw std::bad_alloc();
+}
+
+void *operator new[](std::size_t size)
+{
+    return ::operator new(size);
+}
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept
+{
+    ++allocations;
+    return std::malloc(size == 0 ? 1 : size);
+}
+
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept
+{
+    return ::operator new(size, std::nothrow);
+}
+
+void operator delete(void *pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete[](void *pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete(void *pointer, std::size_t) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete[](void *pointer, std::size_t) noexcept
+{
+    std::free(pointer);
+}
+
+// Smallest batch worth timing, and the repetitions whose fastest is kept
+static constexpr auto TARGET = std::chrono::milliseconds(50);
+static constexpr std::size_t REPETITIONS = 5;
+
+// Size of the chunks a document is fed in
+static constexpr std::size_t CHUNK = 4096;
+
+#ifdef _WIN32
+static constexpr std::string_view MODULE = ".dll";
+#else
+static constexpr std::string_view MODULE = ".so";
+#endif
+
+// Keeps the optimizer from dropping the measured work
+static volatile std::size_t sink = 0;
+
+struct Input {
+    std::string name;
+    std::string data;
+    std::string schema;
+    // The same schema in the binary encoding
+    std::string binary;
+};
+
+// Deterministic 64-bit generator, the inputs must not change between runs
+class Random {
+  private:
+    std::uint64_t _state;
+
+  public:
+    explicit Random(std::uint64_t seed) : _state(seed) {}
+
+    std::uint64_t next()
+    {
+        _state = _state * 6364136223846793005ULL + 1442695040888963407ULL;
+        return _state >> 33;
+    }
+};
+
+static std::string node(std::string_view type, std::string_view constraints,
+    std::string_view data = {})
+{
+    std::string node = fmt::format(
+        R"({{"type":"{}","constraints":[{}])", type, constraints);
+    if (!data.empty()) {
+        node += fmt::format(R"(,"data":{})", data);
+    }
+
+    return node + "}";
+}
+
+using Kind = Blueprint::JSON::Kind;
+
+static std::string varint(std::uint64_t value)
+{
+    std::string out;
+    for (; value >= 0x80; value >>= 7) {
+        out += static_cast<char>((value & 0x7f) | 0x80);
+    }
+
+    return out + static_cast<char>(value);
+}
+
+// Binary constraint with an INTEGER operand, tags follow the TS flags
+static std::string constraint(std::uint8_t tag, std::int64_t value)
+{
+    std::uint64_t zigzag = static_cast<std::uint64_t>(value) << 1
+        ^ static_cast<std::uint64_t>(value >> 63);
+
+    return std::string(1, static_cast<char>(tag))
+        + static_cast<char>(Blueprint::Reader::Tag::INTEGER) + varint(zigzag);
+}
+
+static std::string wire(Kind kind, std::size_t count,
+    std::string_view constraints, std::string_view data = {})
+{
+    return static_cast<char>(kind) + varint(count) + std::string(constraints)
+        + std::string(data);
+}
+
+static std::string header()
+{
+    return {static_cast<char>(Blueprint::Reader::MAGIC),
+        static_cast<char>(Blueprint::Reader::VERSION)};
+}
+
+// Object with fields alternating between numbers and strings
+static Input flat(std::string_view size, std::size_t fields)
+{
+    Random random(fields);
+    std::string data = "{";
+    std::string members;
+    std::string keys;
+    std::string nodes;
+
+    for (std::size_t i = 0; i < fields; ++i) {
+        std::string key = fmt::format("field_{}", i);
+        bool number = i % 2 == 0;
+        data += fmt::format(R"({}"{}":)", i == 0 ? "" : ",", key);
+        data += number ? fmt::format("{}", random.next() % 100000)
+                       : fmt::format(R"("value {}")", random.next());
+        members += fmt::format(R"({}"{}":{})", i == 0 ? "" : ",", key,
+            number ? node("number", R"({"MIN_VALUE":0})")
+                   : node("string", R"({"MAX_LENGTH":64})"));
+        keys += varint(key.size()) + key;
+        nodes += number ? wire(Kind::NUMBER, 1, constraint(0, 0))
+                        : wire(Kind::STRING, 1, constraint(3, 64));
+    }
+
+    return {.name = fmt::format("flat/{}", size),
+        .data = data + "}",
+        .schema = node("object", "", "{" + members + "}"),
+        .binary = header()
+            + wire(Kind::OBJECT, 0, "", varint(fields) + keys + nodes)};
+}
+
+// Arrays nested depth times around a single number
+static Input deep(std::size_t depth)
+{
+    std::string data = std::string(depth, '[') + "1" + std::string(depth, ']');
+    std::string schema = node("number", "");
+    std::string binary = header();
+    for (std::size_t i = 0; i < depth; ++i) {
+        schema = node("array", R"({"MAX_LENGTH":1})", schema);
+        binary += wire(Kind::ARRAY, 1, constraint(3, 1));
+    }
+
+    return {.name = fmt::format("deep/{}", depth),
+        .data = data,
+        .schema = schema,
+        .binary = binary + wire(Kind::NUMBER, 0, "")};
+}
+
+// Array of integers and reals
+static Input numbers(std::string_view size, std::size_t count)
+{
+    Random random(count);
+    std::string data = "[";
+
+    for (std::size_t i = 0; i < count; ++i) {
+        std::uint64_t value = random.next();
+        data += i == 0 ? "" : ",";
+        data += i % 4 == 3
+            ? fmt::format("{}.{}e-3", value % 100000, value % 1000)
+            : fmt::format("{}", static_cast<std::int64_t>(value % 2000000)
+                                    - 1000000);
+    }
+
+    return {.name = fmt::format("numbers/{}", size),
+        .data = data + "]",
+        .schema = node("array", "",
+            node("number",
+                R"({"MIN_VALUE":-1000000},{"MAX_VALUE":1000000})")),
+        .binary = header() + wire(Kind::ARRAY, 0, "")
+            + wire(Kind::NUMBER, 2,
+                constraint(0, -1000000) + constraint(1, 1000000))};
+}
+
+// Array of long strings with escapes
+static Input strings(std::string_view size, std::size_t count)
+{
+    Random random(count);
+    std::string data = "[";
+
+    for (std::size_t i = 0; i < count; ++i) {
+        std::string text;
+        std::size_t length = 16 + random.next() % 112;
+        for (std::size_t j = 0; j < length; ++j) {
+            text += j % 29 == 28 ? std::string("\\\"")
+                                 : std::string(1,
+                                     static_cast<char>(
+                                         'a' + random.next() % 26));
+        }
+        data += fmt::format(R"({}"{}")", i == 0 ? "" : ",", text);
+    }
+
+    return {.name = fmt::format("strings/{}", size),
+        .data = data + "]",
+        .schema = node("array", "", node("string", R"({"MAX_LENGTH":256})")),
+        .binary = header() + wire(Kind::ARRAY, 0, "")
+            + wire(Kind::STRING, 1, constraint(3, 256))};
+}
+
+// Array of typical API records, for payloads of a few kilobytes
+static Input records(std::string_view size, std::size_t count)
+{
+    Random random(count);
+    std::string data = "[";
+
+    for (std::size_t i = 0; i < count; ++i) {
+        std::uint64_t value = random.next();
+        data += fmt::format(
+            R"({}{{"id":{},"name":"user {}","email":"user{}@example.com",)"
+            R"("score":{}.{},"tags":["tag{}","tag{}"]}})",
+            i == 0 ? "" : ",", i, value % 10000, value % 100000, value % 100,
+            value % 10, value % 7, value % 5);
+    }
+
+    std::string fields = fmt::format(
+        R"("id":{},"name":{},"email":{},"score":{},"tags":{})",
+        node("number", R"({"MIN_VALUE":0})"),
+        node("string", R"({"MAX_LENGTH":64})"),
+        node("string", R"({"MIN_LENGTH":3})"), node("number", ""),
+        node("array", R"({"MAX_LENGTH":8})", node("string", "")));
+    std::string keys;
+    for (std::string_view key : {"id", "name", "email", "score", "tags"}) {
+        keys += varint(key.size()) + std::string(key);
+    }
+
+    return {.name = fmt::format("records/{}", size),
+        .data = data + "]",
+        .schema = node("array", "", node("object", "", "{" + fields + "}")),
+        .binary = header() + wire(Kind::ARRAY, 0, "")
+            + wire(Kind::OBJECT, 0, "", varint(5) + keys)
+            + wire(Kind::NUMBER, 1, constraint(0, 0))
+            + wire(Kind::STRING, 1, constraint(3, 64))
+            + wire(Kind::STRING, 1, constraint(2, 3))
+            + wire(Kind::NUMBER, 0, "")
+            + wire(Kind::ARRAY, 1, constraint(3, 8))
+            + wire(Kind::STRING, 0, "")};
+}
+
+// Records of records() one per line, validated against a single record
+static Input lines(std::string_view size, std::size_t count)
+{
+    Random random(count);
+    std::string data;
+
+    for (std::size_t i = 0; i < count; ++i) {
+        std::uint64_t value = random.next();
+        data += fmt::format(
+            R"({{"id":{},"name":"user {}","email":"user{}@example.com",)"
+            R"("score":{}.{},"tags":["tag{}","tag{}"]}}{})",
+            i, value % 10000, value % 100000, value % 100, value % 10,
+            value % 7, value % 5, '\n');
+    }
+
+    std::string fields = fmt::format(
+        R"("id":{},"name":{},"email":{},"score":{},"tags":{})",
+        node("number", R"({"MIN_VALUE":0})"),
+        node("string", R"({"MAX_LENGTH":64})"),
+        node("string", R"({"MIN_LENGTH":3})"), node("number", ""),
+        node("array", R"({"MAX_LENGTH":8})", node("string", "")));
+
+    return {.name = fmt::format("ndjson/{}", size),
+        .data = data,
+        .schema = node("object", "", "{" + fields + "}"),
+        .binary = {}};
+}
+
+// Big-endian operand of a MessagePack type
+static void append(std::string &out, std::uint8_t tag, std::uint64_t value,
+    std::size_t size)
+{
+    out += static_cast<char>(tag);
+    for (std::size_t i = size; i > 0; --i) {
+        out += static_cast<char>(value >> ((i - 1) * 8));
+    }
+}
+
+// MessagePack form of a parsed document, strings keep their JSON escapes
+// Text of a JSON string, MessagePack carries it unescaped. The inputs only
+// use escapes of two characters.
+static std::string unescape(std::string_view text)
+{
+    std::string out;
+    for (std::size_t i = 0; i < text.size(); ++i) {
+        if (text[i] != '\\' || i + 1 == text.size()) {
+            out += text[i];
+            continue;
+        }
+
+        switch (text[++i]) {
+            case 'b': out += '\b'; break;
+            case 'f': out += '\f'; break;
+            case 'n': out += '\n'; break;
+            case 'r': out += '\r'; break;
+            case 't': out += '\t'; break;
+            default: out += text[i]; break;
+        }
+    }
+
+    return out;
+}
+
+static void pack(std::string &out, const Blueprint::JSON::Value &value)
+{
+    switch (value.kind()) {
+        case Kind::NULL_VALUE: out += '\xc0'; break;
+        case Kind::BOOLEAN: out += value.boolean() ? '\xc3' : '\xc2'; break;
+        case Kind::NUMBER: {
+            if (!value.integral()) {
+                double real = value.number();
+                std::uint64_t bits;
+                std::memcpy(&bits, &real, sizeof(bits));
+                append(out, 0xcb, bits, 8);
+            } else if (value.integer() >= -32 && value.integer() < 128) {
+                out += static_cast<char>(value.integer());
+            } else {
+                append(out, 0xd3, static_cast<std::uint64_t>(value.integer()),
+                    8);
+            }
+            break;
+        }
+        case Kind::STRING: {
+            std::string text = unescape(value.string());
+            if (text.size() < 32) {
+                out += static_cast<char>(0xa0 | text.size());
+            } else {
+                append(out, 0xdb, text.size(), 4);
+            }
+            out += text;
+            break;
+        }
+        case Kind::ARRAY:
+        case Kind::OBJECT: {
+            bool object = value.kind() == Kind::OBJECT;
+            if (value.size() < 16) {
+                out += static_cast<char>((object ? 0x80 : 0x90) | value.size());
+            } else {
+                append(out, object ? 0xdf : 0xdd, value.size(), 4);
+            }
+
+            std::size_t count = value.size() * (object ? 2 : 1);
+            for (std::size_t i = 0; i < count; ++i) {
+                pack(out, value.children()[i]);
+            }
+            break;
+        }
+    }
+}
+
+static std::vector<Input> inputs()
+{
+    return {
+        flat("small", 8),
+        flat("medium", 500),
+        flat("huge", 100000),
+        deep(10),
+        deep(100),
+        deep(1000),
+        deep(10000),
+        numbers("small", 16),
+        numbers("medium", 2000),
+        numbers("huge", 500000),
+        strings("small", 4),
+        strings("medium", 200),
+        strings("huge", 50000),
+        records("1k", 9),
+        records("10k", 90),
+    };
+}
+
+// Times op and prints the fastest repetition, with the records per second
+// of an op validating that many
+static void measure(std::string_view name, std::size_t bytes,
+    const std::function<void()> &op, std::size_t records = 0)
+{
+    using Clock = std::chrono::steady_clock;
+
+    // Grows the batch until it is long enough to time
+    std::size_t iterations = 1;
+    while (true) {
+        Clock::time_point start = Clock::now();
+        for (std::size_t i = 0; i < iterations; ++i) {
+            op();
+        }
+        if (Clock::now() - start >= TARGET || iterations >= (1 << 30)) {
+            break;
+        }
+        iterations *= 2;
+    }
+
+    double best = 0;
+    std::size_t allocated = allocations;
+    for (std::size_t repetition = 0; repetition < REPETITIONS; ++repetition) {
+        Clock::time_point start = Clock::now();
+        for (std::size_t i = 0; i < iterations; ++i) {
+            op();
+        }
+        std::chrono::duration<double, std::nano> elapsed = Clock::now() - start;
+        double ns = elapsed.count() / static_cast<double>(iterations);
+        best = repetition == 0 ? ns : std::min(best, ns);
+    }
+    allocated = allocations - allocated;
+
+    std::string rate;
+    if (records != 0) {
+        rate = fmt::format(",\"records_per_second\":{:.0f}",
+            static_cast<double>(records) / best * 1e9);
+    }
+
+    fmt::print(
+        "{{\"benchmark\":\"{}\",\"bytes\":{},\"iterations\":{},"
+        "\"ns_per_op\":{:.1f},\"bytes_per_second\":{:.0f}{},"
+        "\"allocs_per_op\":{:.2f}}}\n",
+        name, bytes, iterations, best, static_cast<double>(bytes) / best * 1e9,
+        rate,
+        static_cast<double>(allocated)
+            / static_cast<double>(iterations * REPETITIONS));
+    std::fflush(stdout);
+}
+
+static void lex(Blueprint::JSON::Lexer &lexer, std::string_view data)
+{
+    std::size_t tokens = 0;
+
+    lexer.reset(data);
+    while (true) {
+        std::optional<Blueprint::JSON::Token> token = lexer.nextToken();
+        if (!token.has_value()
+            || token->type() == Blueprint::JSON::Type::END_OF_FILE) {
+            break;
+        }
+        ++tokens;
+    }
+
+    sink = sink + tokens;
+}
+
+// Name of an input usable in a file name
+static std::string slug(std::string_view name)
+{
+    std::string slug(name);
+    std::replace(slug.begin(), slug.end(), '/', '-');
+
+    return slug;
+}
+
+static int dump(std::string_view name, const char *path)
+{
+    for (const Input &input : inputs()) {
+        if (input.name != name) {
+            continue;
+        }
+
+        std::FILE *file = std::fopen(path, "wb");
+        if (file == nullptr) {
+            fmt::print(stderr, "Failed to open '{}'\n", path);
+            return 1;
+        }
+
+        bool written = std::fwrite(input.schema.data(), 1, input.schema.size(),
+                           file)
+            == input.schema.size();
+        if (std::fclose(file) != 0 || !written) {
+            fmt::print(stderr, "Failed to write '{}'\n", path);
+            return 1;
+        }
+
+        return 0;
+    }
+
+    fmt::print(stderr, "Unknown input '{}'\n", name);
+    return 1;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc == 4 && std::string_view(argv[1]) == "--schema") {
+        return dump(argv[2], argv[3]);
+    }
+
+    std::string_view filter = argc > 1 ? argv[1] : "";
+    std::string_view plugins = argc > 2 ? argv[2] : "";
+    auto wanted = [&](std::string_view name) {
+        return name.find(filter) != std::string_view::npos;
+    };
+
+    Blueprint::JSON::Lexer lexer;
+    Blueprint::JSON::Document document;
+    Blueprint::Schema schema;
+    // The deepest inputs are past the default limit
+    schema.setDepth(0);
+
+    for (const Input &input : inputs()) {
+        std::string_view data = input.data;
+
+        std::string name = "lexer/" + input.name;
+        if (wanted(name)) {
+            measure(name, data.size(), [&] { lex(lexer, data); });
+        }
+
+        name = "document/" + input.name;
+        if (wanted(name)) {
+            measure(name, data.size(), [&] {
+                sink = sink + (document.parse(data) != nullptr);
+                document.clear();
+            });
+        }
+
+        for (std::string_view encoding : {"json", "binary"}) {
+            std::string_view text =
+                encoding == "json" ? input.schema : input.binary;
+            name = fmt::format("load/{}/{}", encoding, input.name);
+            if (!wanted(name)) {
+                continue;
+            }
+
+            measure(name, text.size(), [&] {
+                Blueprint::Program program;
+                sink = sink + program.load(text);
+            });
+        }
+
+        Blueprint::Program *program = schema.compile(input.schema);
+        if (program == nullptr) {
+            fmt::print(stderr, "{}: {}\n", input.name, schema.getMessage());
+            return 1;
+        }
+
+        for (Blueprint::Mode mode :
+            {Blueprint::Mode::TREE, Blueprint::Mode::STREAM}) {
+            name = fmt::format("verify/{}/{}",
+                mode == Blueprint::Mode::TREE ? "tree" : "stream", input.name);
+            if (!wanted(name)) {
+                continue;
+            }
+
+            schema.setMode(mode);
+            if (!schema.verify(*program, data)) {
+                fmt::print(stderr, "{}: {}\n", name, schema.getMessage());
+                return 1;
+            }
+
+            measure(name, data.size(),
+                [&] { sink = sink + schema.verify(*program, data); });
+        }
+
+        name = "verify/packed/" + input.name;
+        if (wanted(name)) {
+            std::string packed;
+            pack(packed, *document.parse(data));
+            document.clear();
+            if (!schema.verifyPacked(*program, packed)) {
+                fmt::print(stderr, "{}: {}\n", name, schema.getMessage());
+                return 1;
+            }
+
+            measure(name, packed.size(),
+                [&] { sink = sink + schema.verifyPacked(*program, packed); });
+        }
+
+        // Fed the way a request body arrives, a few kilobytes at a time
+        name = "verify/chunked/" + input.name;
+        if (wanted(name)) {
+            auto feed = [&] {
+                Blueprint::Session session(*program, 0);
+                for (std::size_t i = 0; i < data.size(); i += CHUNK) {
+                    if (!session.feed(data.substr(i, CHUNK))) {
+                        return false;
+                    }
+                }
+
+                return session.end();
+            };
+            if (!feed()) {
+                fmt::print(stderr, "{}: failed\n", name);
+                return 1;
+            }
+
+            measure(name, data.size(), [&] { sink = sink + feed(); });
+        }
+
+        // Validator generated ahead of time, against verify/tree above
+        name = "verify/plugin/" + input.name;
+        std::string path =
+            fmt::format("{}/bench-{}{}", plugins, slug(input.name), MODULE);
+        if (!plugins.empty() && wanted(name)
+            && std::filesystem::exists(path)) {
+            Blueprint::Program *plugin =
+                schema.compilePlugin(path, input.schema);
+            schema.setMode(Blueprint::Mode::TREE);
+            if (plugin == nullptr || plugin->plugin() == nullptr
+                || !plugin->plugin()->verify(data.data(), data.size(), 0)) {
+                fmt::print(stderr, "{}: {}\n", name, schema.getMessage());
+                return 1;
+            }
+
+            measure(name, data.size(),
+                [&] { sink = sink + schema.verify(*plugin, data); });
+
+            if (plugin->release()) {
+                delete plugin;
+            }
+        }
+
+        // Both encodings must load a schema the input passes
+        Blueprint::Program *binary = schema.compile(input.binary);
+        if (binary == nullptr || !schema.verify(*binary, data)) {
+            fmt::print(stderr, "{}: {}\n", input.name, schema.getMessage());
+            return 1;
+        }
+
+        if (binary->release()) {
+            delete binary;
+        }
+        if (program->release()) {
+            delete program;
+        }
+    }
+
+    // Independent records spread over the pool, one document each in a
+    // batch and one line each in NDJSON
+    Input input = lines("100k", 100000);
+    std::vector<const char *> documents;
+    std::vector<std::size_t> lengths;
+    for (std::size_t start = 0; start < input.data.size();) {
+        std::size_t end = input.data.find('\n', start);
+        documents.push_back(input.data.data() + start);
+        lengths.push_back(end - start);
+        start = end + 1;
+    }
+    std::vector<std::uint8_t> results(documents.size());
+
+    Blueprint::Program *program = schema.compile(input.schema);
+    if (program == nullptr) {
+        fmt::print(stderr, "{}: {}\n", input.name, schema.getMessage());
+        return 1;
+    }
+
+    std::vector<std::size_t> counts = {1, 2, 4,
+        std::max<std::size_t>(std::thread::hardware_concurrency(), 1)};
+    std::sort(counts.begin(), counts.end());
+    counts.erase(std::unique(counts.begin(), counts.end()), counts.end());
+
+    schema.setMode(Blueprint::Mode::TREE);
+    for (std::size_t threads : counts) {
+        schema.setThreads(threads);
+
+        std::string name =
+            fmt::format("verify/batch/threads-{}/{}", threads, input.name);
+        if (wanted(name)) {
+            auto batch = [&] {
+                return schema.verify(*program, documents.data(),
+                    lengths.data(), documents.size(), results.data());
+            };
+            if (!batch()) {
+                fmt::print(stderr, "{}: {}\n", name, schema.getMessage());
+                return 1;
+            }
+
+            measure(
+                name, input.data.size(), [&] { sink = sink + batch(); },
+                documents.size());
+        }
+
+        name = fmt::format("verify/lines/threads-{}/{}", threads, input.name);
+        if (wanted(name)) {
+            if (!schema.verifyLines(*program, input.data)) {
+                fmt::print(stderr, "{}: {}\n", name, schema.getMessage());
+                return 1;
+            }
+
+            measure(
+                name, input.data.size(),
+                [&] { sink = sink + schema.verifyLines(*program, input.data); },
+                documents.size());
+        }
+    }
+
+    if (program->release()) {
+        delete program;
+    }
+
+    return 0;
+}
@@ -0,0 +1,69 @@
+import { b } from "~/sources/mod.ts";
+
+// Event-loop lag while validations run, for `verify` and `verifyAsync`. A
+// timer asks to fire every millisecond and records how late it fired,
+// while a number of clients validate a ~1 MB document back to back. Every
+// result is printed as one JSON object per line.
+//
+//     deno run -A bench/lag.ts [clients] [seconds]
+
+const clients = Number(Deno.args[0] ?? 16);
+const seconds = Number(Deno.args[1] ?? 3);
+
+const schema = b.array(b.object({
+  id: b.number().min(0),
+  name: b.string().max(64),
+  tags: b.array(b.string()).max(8),
+}));
+const data = Array.from({ length: 12000 }, (_, i) => ({
+  id: i,
+  name: `user ${i}`,
+  tags: [`tag${i % 7}`, `tag${i % 5}`],
+}));
+
+const percentile = (sorted: number[], p: number) =>
+  sorted[Math.min(sorted.length - 1, Math.floor(sorted.length * p))] ?? 0;
+
+for (const mode of ["sync", "async"] as const) {
+  using handle = await b.init();
+  const lags: number[] = [];
+  let done = 0;
+  let running = true;
+
+  let last = performance.now();
+  const timer = setInterval(() => {
+    const now = performance.now();
+    lags.push(Math.max(0, now - last - 1));
+    last = now;
+  }, 1);
+
+  const client = async () => {
+    while (running) {
+      if (mode === "sync") {
+        handle.verify(schema, data);
+        // Yields so the timer gets a chance between validations
+        await new Promise((resolve) => setTimeout(resolve, 0));
+      } else {
+        await handle.verifyAsync(schema, data);
+      }
+      done++;
+    }
+  };
+
+  const start = performance.now();
+  const stop = new Promise((resolve) => setTimeout(resolve, seconds * 1000))
+    .then(() => running = false);
+  await Promise.all([stop, ...Array.from({ length: clients }, client)]);
+  const elapsed = (performance.now() - start) / 1000;
+  clearInterval(timer);
+
+  lags.sort((a, b) => a - b);
+  console.log(JSON.stringify({
+    benchmark: `lag/${mode}`,
+    clients,
+    verifications_per_second: Math.round(done / elapsed),
+    lag_p50_ms: Number(percentile(lags, 0.5).toFixed(2)),
+    lag_p99_ms: Number(percentile(lags, 0.99).toFixed(2)),
+    lag_max_ms: Number((lags.at(-1) ?? 0).toFixed(2)),
+  }));
+}
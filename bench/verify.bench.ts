@@ -0,0 +1,37 @@
+import { b } from "~/sources/mod.ts";
+
+// End-to-end latency of a verification from TS, including the encoding of
+// the data, for JSON text and MessagePack payloads of about 1 and 10 KB.
+//
+//     deno bench -A bench/verify.bench.ts
+
+const handle = await b.init();
+
+const schema = b.array(b.object({
+  id: b.number().min(0),
+  name: b.string().max(64),
+  email: b.string().min(3),
+  score: b.number(),
+  tags: b.array(b.string()).max(8),
+}));
+
+const records = (count: number) =>
+  Array.from({ length: count }, (_, i) => ({
+    id: i,
+    name: `user ${i * 7919 % 10000}`,
+    email: `user${i * 104729 % 100000}@example.com`,
+    score: i * 0.37,
+    tags: [`tag${i % 7}`, `tag${i % 5}`],
+  }));
+
+for (const [size, count] of [["1k", 9], ["10k", 90]] as const) {
+  const data = records(count);
+
+  Deno.bench(`verify/json/${size}`, { group: size, baseline: true }, () => {
+    handle.verify(schema, data);
+  });
+
+  Deno.bench(`verify/packed/${size}`, { group: size }, () => {
+    handle.verifyPacked(schema, data);
+  });
+}
@@ -0,0 +1,787 @@
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <fmt/core.h>
+#include <iterator>
+#include <map>
+#include <set>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "JSON/Kind.hpp"
+#include "JSON/Number.hpp"
+#include "Mapping.hpp"
+#include "Plugin.hpp"
+#include "Program.hpp"
+#include "Reader.hpp"
+#include "Set.hpp"
+#include "Table.hpp"
+
+// Ahead-of-time validator generator. Reads a schema as written by
+// ISchema.toString(), or in the binary encoding, and writes a C++ source
+// validating documents against it with every key, bound and literal
+// inlined. Built into a plugin library, it is loaded with compile_plugin
+// and then used by every verify call on the returned program.
+//
+//     blueprint_codegen <schema> <output.cpp>
+//
+// The generated code only decides acceptance: whatever it turns down goes
+// through the interpreter, which makes the same decision and the error.
+
+using Kind = Blueprint::JSON::Kind;
+using Number = Blueprint::JSON::Number;
+using Node = Blueprint::Program::Node;
+using Instruction = Blueprint::Program::Instruction;
+using Opcode = Blueprint::Program::Opcode;
+
+// Integers read inline have at most 18 digits, so thresholds past this
+// behave the same as any larger one
+static constexpr std::int64_t LIMIT = std::int64_t(1) << 62;
+
+// Entries of a lookup table compared whole once a switch narrowed them down
+// to this many
+static constexpr std::size_t SCAN = 2;
+
+// Source text, indented four spaces per level
+class Output {
+  private:
+    std::string _text;
+    std::size_t _level = 0;
+
+  public:
+    template <typename... Args>
+    void line(fmt::format_string<Args...> fmt, Args &&...args)
+    {
+        _text.append(_level * 4, ' ');
+        fmt::format_to(
+            std::back_inserter(_text), fmt, std::forward<Args>(args)...);
+        _text += '\n';
+    }
+
+    void blank()
+    {
+        _text += '\n';
+    }
+
+    void indent()
+    {
+        ++_level;
+    }
+
+    void dedent()
+    {
+        --_level;
+    }
+
+    const std::string &text() const
+    {
+        return _text;
+    }
+};
+
+// C++ string literal holding exactly the bytes of text
+static std::string quote(std::string_view text)
+{
+    std::string out = "\"";
+    for (char ch : text) {
+        auto byte = static_cast<unsigned char>(ch);
+        if (ch == '"' || ch == '\\') {
+            out += '\\';
+            out += ch;
+        } else if (byte < 0x20 || byte > 0x7e) {
+            out += fmt::format("\\{:03o}", byte);
+        } else {
+            out += ch;
+        }
+    }
+
+    return out + "\"";
+}
+
+// C++ character literal of a byte
+static std::string character(char ch)
+{
+    auto byte = static_cast<unsigned char>(ch);
+    if (ch == '\'' || ch == '\\' || byte < 0x20 || byte > 0x7e) {
+        return fmt::format("'\\x{:02x}'", byte);
+    }
+
+    return fmt::format("'{}'", ch);
+}
+
+static std::string literal(std::int64_t value)
+{
+    return value == INT64_MIN ? "INT64_MIN" : fmt::format("{}", value);
+}
+
+static std::string constant(const Number &number)
+{
+    return number.integral()
+        ? fmt::format("Number::fromInteger({})", literal(number.integer()))
+        : fmt::format("Number::fromReal({:a})", number.real());
+}
+
+// Lowest integer not below a MIN_VALUE bound
+static std::int64_t lowest(const Number &bound)
+{
+    if (bound.integral()) {
+        return std::clamp(bound.integer(), -LIMIT, LIMIT);
+    }
+
+    double value = std::clamp(std::ceil(bound.real()), -0x1p62, 0x1p62);
+    return static_cast<std::int64_t>(value);
+}
+
+// Highest integer not above a MAX_VALUE bound
+static std::int64_t highest(const Number &bound)
+{
+    if (bound.integral()) {
+        return std::clamp(bound.integer(), -LIMIT, LIMIT);
+    }
+
+    double value = std::clamp(std::floor(bound.real()), -0x1p62, 0x1p62);
+    return static_cast<std::int64_t>(value);
+}
+
+static bool rejects(const Node &node)
+{
+    return std::any_of(node.checks.begin(), node.checks.end(),
+        [](const Instruction &instruction) {
+            return instruction.opcode == Opcode::REJECT
+                || instruction.opcode == Opcode::REQUIRED;
+        });
+}
+
+// Writes the validator of a loaded program
+class Generator {
+  private:
+    // Key or string of a lookup table and its index there
+    struct Entry {
+        std::string_view text;
+        std::size_t index;
+    };
+
+    const Blueprint::Program &_program;
+    Output _constants;
+    // Lookup tables of keys and strings, ahead of the nodes using them
+    Output _lookups;
+    Output _functions;
+    std::vector<bool> _reached;
+    std::vector<std::size_t> _pending;
+
+    // Queues a node for generation, once
+    void reach(std::size_t index)
+    {
+        if (index >= _reached.size()) {
+            _reached.resize(index + 1, false);
+        }
+
+        if (!_reached[index]) {
+            _reached[index] = true;
+            _pending.push_back(index);
+        }
+    }
+
+    // Switches on the byte telling the most entries of one size apart,
+    // until few enough are left to compare whole
+    void split(const std::vector<Entry> &entries, std::size_t size)
+    {
+        Output &out = _lookups;
+        if (entries.size() <= SCAN) {
+            for (const Entry &entry : entries) {
+                if (size == 0) {
+                    out.line("return {};", entry.index);
+                    return;
+                }
+
+                out.line("if (std::memcmp(text.data(), {}, {}) == 0) {{",
+                    quote(entry.text), size);
+                out.line("    return {};", entry.index);
+                out.line("}}");
+            }
+            out.line("return SIZE_MAX;");
+            return;
+        }
+
+        std::size_t position = 0;
+        std::size_t most = 0;
+        for (std::size_t i = 0; i < size; ++i) {
+            std::set<char> bytes;
+            for (const Entry &entry : entries) {
+                bytes.insert(entry.text[i]);
+            }
+
+            if (bytes.size() > most) {
+                most = bytes.size();
+                position = i;
+            }
+        }
+
+        std::map<char, std::vector<Entry>> groups;
+        for (const Entry &entry : entries) {
+            groups[entry.text[position]].push_back(entry);
+        }
+
+        out.line("switch (text[{}]) {{", position);
+        out.indent();
+        for (const auto &[byte, group] : groups) {
+            out.line("case {}:", character(byte));
+            out.indent();
+            split(group, size);
+            out.dedent();
+        }
+        out.line("default: return SIZE_MAX;");
+        out.dedent();
+        out.line("}}");
+    }
+
+    // Writes a function returning the index of text in a table, SIZE_MAX
+    // when it is not there
+    void lookup(std::string_view name, const Blueprint::Table &table)
+    {
+        std::map<std::size_t, std::vector<Entry>> sizes;
+        for (std::size_t i = 0; i < table.size(); ++i) {
+            sizes[table.name(i).size()].push_back(
+                {.text = table.name(i), .index = i});
+        }
+
+        Output &out = _lookups;
+        out.line("static std::size_t {}(std::string_view text)", name);
+        out.line("{{");
+        out.indent();
+        out.line("switch (text.size()) {{");
+        out.indent();
+        for (const auto &[size, entries] : sizes) {
+            out.line("case {}:", size);
+            out.indent();
+            split(entries, size);
+            out.dedent();
+        }
+        out.line("default: return SIZE_MAX;");
+        out.dedent();
+        out.line("}}");
+        out.dedent();
+        out.line("}}");
+        out.blank();
+    }
+
+    // Fails unless text is in the string members of a set of node index
+    void strings(Output &out, std::size_t index, std::size_t operand)
+    {
+        const Blueprint::Table &table =
+            _program[index].sets[operand].strings();
+        if (table.size() == 0) {
+            out.line("return false;");
+            return;
+        }
+
+        std::string name = fmt::format("strings{}_{}", index, operand);
+        lookup(name, table);
+        out.line("if ({}(text) == SIZE_MAX) {{", name);
+        out.line("    return false;");
+        out.line("}}");
+    }
+
+    // Reads a number and runs the bounds and VALUES of code on it
+    void numbers(Output &out, std::size_t index,
+        const std::vector<Instruction> &code)
+    {
+        const Node &node = _program[index];
+
+        out.line("std::int64_t integer = 0;");
+        out.line("Number number;");
+        out.blank();
+        out.line("switch (cursor.number(integer, number)) {{");
+        out.indent();
+
+        // Inline integers compare against integer thresholds
+        out.line("case Cursor::Numeral::INTEGER:");
+        out.indent();
+        for (const Instruction &instruction : code) {
+            switch (instruction.opcode) {
+                case Opcode::MIN_VALUE:
+                    out.line("if (integer < {}) {{",
+                        literal(lowest(instruction.bound)));
+                    out.line("    return false;");
+                    out.line("}}");
+                    break;
+                case Opcode::MAX_VALUE:
+                    out.line("if (integer > {}) {{",
+                        literal(highest(instruction.bound)));
+                    out.line("    return false;");
+                    out.line("}}");
+                    break;
+                case Opcode::VALUES: {
+                    std::set<std::int64_t> labels;
+                    for (const Number &member :
+                        node.sets[instruction.operand].numbers()) {
+                        double real = member.real();
+                        if (member.integral()) {
+                            labels.insert(member.integer());
+                        } else if (std::abs(real) < 0x1p62
+                            && real == std::floor(real)) {
+                            labels.insert(static_cast<std::int64_t>(real));
+                        }
+                    }
+
+                    if (labels.empty()) {
+                        out.line("return false;");
+                        break;
+                    }
+
+                    out.line("switch (integer) {{");
+                    out.indent();
+                    std::size_t i = 0;
+                    for (std::int64_t label : labels) {
+                        out.line("case {}:{}", literal(label),
+                            ++i == labels.size() ? " break;" : "");
+                    }
+                    out.line("default: return false;");
+                    out.dedent();
+                    out.line("}}");
+                    break;
+                }
+                default: break;
+            }
+        }
+        out.line("return true;");
+        out.dedent();
+
+        // Anything else compares exactly against parsed constants
+        out.line("case Cursor::Numeral::NUMBER:");
+        out.indent();
+        for (std::size_t i = 0; i < code.size(); ++i) {
+            const Instruction &instruction = code[i];
+            std::string name = fmt::format("BOUND{}_{}", index, i);
+
+            switch (instruction.opcode) {
+                case Opcode::MIN_VALUE:
+                case Opcode::MAX_VALUE:
+                    _constants.line("static const Number {} = {};", name,
+                        constant(instruction.bound));
+                    out.line("if (number {} {}) {{",
+                        instruction.opcode == Opcode::MIN_VALUE ? "<" : ">",
+                        name);
+                    out.line("    return false;");
+                    out.line("}}");
+                    break;
+                case Opcode::VALUES: {
+                    const std::vector<Number> &members =
+                        node.sets[instruction.operand].numbers();
+                    if (members.empty()) {
+                        out.line("return false;");
+                        break;
+                    }
+
+                    name = fmt::format("VALUES{}_{}", index, i);
+                    _constants.line("static const Number {}[] = {{", name);
+                    _constants.indent();
+                    for (const Number &member : members) {
+                        _constants.line("{},", constant(member));
+                    }
+                    _constants.dedent();
+                    _constants.line("}};");
+
+                    out.line("if (!std::binary_search(");
+                    out.line(
+                        "        std::begin({0}), std::end({0}), number)) {{",
+                        name);
+                    out.line("    return false;");
+                    out.line("}}");
+                    break;
+                }
+                default: break;
+            }
+        }
+        out.line("return true;");
+        out.dedent();
+
+        out.line("default: return false;");
+        out.dedent();
+        out.line("}}");
+    }
+
+    // Checks an array element against the VALUES of its array, on a copy
+    // of the cursor so the element is then read again by its own node
+    void element(std::size_t index)
+    {
+        const Node &node = _program[index];
+        bool yes = true;
+        bool no = true;
+        bool null = true;
+        for (const Instruction &instruction : node.elements) {
+            const Blueprint::Set &set = node.sets[instruction.operand];
+            yes = yes && set.contains(Kind::BOOLEAN, {}, "true");
+            no = no && set.contains(Kind::BOOLEAN, {}, "false");
+            null = null && set.contains(Kind::NULL_VALUE, {}, "null");
+        }
+
+        Output &out = _functions;
+        out.line("// Whether an element of node {} is in its VALUES", index);
+        out.line("static bool element{}(Cursor cursor)", index);
+        out.line("{{");
+        out.indent();
+        out.line("switch (cursor.peek()) {{");
+        out.indent();
+
+        out.line("case '\"': {{");
+        out.indent();
+        out.line("std::string_view text;");
+        out.line("if (!cursor.string(text)) {{");
+        out.line("    return false;");
+        out.line("}}");
+        out.blank();
+        for (const Instruction &instruction : node.elements) {
+            strings(out, index, instruction.operand);
+        }
+        out.line("return true;");
+        out.dedent();
+        out.line("}}");
+
+        out.line("case 't':");
+        out.line("case 'f': {{");
+        out.indent();
+        if (yes || no) {
+            out.line("bool value = false;");
+            out.line("return cursor.boolean(value){};",
+                yes && no ? ""
+                    : yes ? " && value"
+                          : " && !value");
+        } else {
+            out.line("return false;");
+        }
+        out.dedent();
+        out.line("}}");
+
+        out.line("case 'n': return {};", null ? "cursor.null()" : "false");
+        out.line("case '[':");
+        out.line("case '{{': return false;");
+        out.line("default: break;");
+        out.dedent();
+        out.line("}}");
+        out.blank();
+
+        numbers(out, index, node.elements);
+        out.dedent();
+        out.line("}}");
+        out.blank();
+    }
+
+    void array(std::size_t index)
+    {
+        const Node &node = _program[index];
+        Output &out = _functions;
+        out.line("if (!cursor.enter('[')) {{");
+        out.line("    return false;");
+        out.line("}}");
+        out.blank();
+        if (!node.sizes.empty()) {
+            out.line("std::size_t count = 0;");
+        }
+        out.line("if (!cursor.take(']')) {{");
+        out.indent();
+        out.line("do {{");
+        out.indent();
+        std::string element = node.elements.empty()
+            ? ""
+            : fmt::format("!element{}(cursor) || ", index);
+        out.line("if ({}!node{}(cursor)) {{", element, node.element);
+        out.line("    return false;");
+        out.line("}}");
+        if (!node.sizes.empty()) {
+            out.line("++count;");
+        }
+        out.dedent();
+        out.line("}} while (cursor.take(','));");
+        out.blank();
+        out.line("if (!cursor.take(']')) {{");
+        out.line("    return false;");
+        out.line("}}");
+        out.dedent();
+        out.line("}}");
+        out.blank();
+        out.line("cursor.leave();");
+
+        for (const Instruction &instruction : node.sizes) {
+            if (instruction.opcode == Opcode::MIN_LENGTH
+                && instruction.operand == 0) {
+                continue;
+            }
+
+            out.line("if (count {} {}u) {{",
+                instruction.opcode == Opcode::MIN_LENGTH ? "<" : ">",
+                instruction.operand);
+            out.line("    return false;");
+            out.line("}}");
+        }
+        out.line("return true;");
+    }
+
+    void object(std::size_t index)
+    {
+        const Node &node = _program[index];
+        Output &out = _functions;
+        out.line("if (!cursor.enter('{{')) {{");
+        out.line("    return false;");
+        out.line("}}");
+        out.blank();
+        out.line("if (!cursor.take('}}')) {{");
+        out.indent();
+        out.line("do {{");
+        out.indent();
+        out.line("std::string_view key;");
+        out.line("if (!cursor.string(key) || !cursor.take(':')) {{");
+        out.line("    return false;");
+        out.line("}}");
+        out.blank();
+
+        // Only the first member of a repeated key is matched, as the rest
+        // are read the same way
+        if (node.keys.size() != 0) {
+            std::string name = fmt::format("keys{}", index);
+            lookup(name, node.keys);
+            out.line("switch ({}(key)) {{", name);
+            out.indent();
+            for (std::size_t slot = 0; slot < node.keys.size(); ++slot) {
+                out.line("case {}:", slot);
+                out.indent();
+                out.line("if (!node{}(cursor)) {{", node.fields[slot]);
+                out.line("    return false;");
+                out.line("}}");
+                out.line("continue;");
+                out.dedent();
+            }
+            out.line("default: break;");
+            out.dedent();
+            out.line("}}");
+            out.blank();
+        }
+
+        if (node.open) {
+            out.line("if (!cursor.skip()) {{");
+            out.line("    return false;");
+            out.line("}}");
+        } else {
+            out.line("return false;");
+        }
+        out.dedent();
+        out.line("}} while (cursor.take(','));");
+        out.blank();
+        out.line("if (!cursor.take('}}')) {{");
+        out.line("    return false;");
+        out.line("}}");
+        out.dedent();
+        out.line("}}");
+        out.blank();
+        out.line("cursor.leave();");
+        out.line("return true;");
+    }
+
+    void generate(std::size_t index)
+    {
+        const Node &node = _program[index];
+        Output &out = _functions;
+
+        // Fails on every value, whatever it is
+        if (rejects(node)) {
+            out.line("static bool node{}(Cursor &)", index);
+            out.line("{{");
+            out.line("    return false;");
+            out.line("}}");
+            out.blank();
+            return;
+        }
+
+        // Defined ahead of the array calling it
+        if (node.kind == Kind::ARRAY && !node.elements.empty()) {
+            element(index);
+        }
+
+        out.line("static bool node{}(Cursor &cursor)", index);
+        out.line("{{");
+        out.indent();
+
+        switch (node.kind) {
+            case Kind::NUMBER: numbers(out, index, node.checks); break;
+            case Kind::STRING:
+                out.line("std::string_view text;");
+                out.line("if (!cursor.string(text)) {{");
+                out.line("    return false;");
+                out.line("}}");
+                out.blank();
+                for (const Instruction &instruction : node.checks) {
+                    if (instruction.opcode == Opcode::ENUM) {
+                        strings(out, index, instruction.operand);
+                        continue;
+                    }
+
+                    if (instruction.opcode == Opcode::MIN_LENGTH
+                        && instruction.operand == 0) {
+                        continue;
+                    }
+
+                    out.line("if (text.size() {} {}u) {{",
+                        instruction.opcode == Opcode::MIN_LENGTH ? "<" : ">",
+                        instruction.operand);
+                    out.line("    return false;");
+                    out.line("}}");
+                }
+                out.line("return true;");
+                break;
+            case Kind::BOOLEAN:
+                out.line("bool value = false;");
+                out.line("return cursor.boolean(value);");
+                break;
+            case Kind::NULL_VALUE: out.line("return cursor.null();"); break;
+            case Kind::ARRAY: array(index); break;
+            case Kind::OBJECT: object(index); break;
+        }
+
+        out.dedent();
+        out.line("}}");
+        out.blank();
+    }
+
+  public:
+    explicit Generator(const Blueprint::Program &program) : _program(program)
+    {
+    }
+
+    // Source of the plugin, schema is the text it embeds
+    std::string source(std::string_view schema)
+    {
+        reach(_program.index(_program.root()));
+        std::vector<std::size_t> order;
+        while (!_pending.empty()) {
+            std::size_t index = _pending.back();
+            _pending.pop_back();
+            order.push_back(index);
+
+            // Children of a rejecting node are never reached
+            const Node &node = _program[index];
+            if (!rejects(node)) {
+                if (node.kind == Kind::ARRAY) {
+                    reach(node.element);
+                }
+                for (std::size_t field : node.fields) {
+                    reach(field);
+                }
+            }
+        }
+
+        std::sort(order.begin(), order.end());
+        for (std::size_t index : order) {
+            generate(index);
+        }
+
+        Output out;
+        out.line("// Generated by blueprint_codegen, do not edit.");
+        out.blank();
+        for (std::string_view header : {"<algorithm>", "<cstddef>",
+                 "<cstdint>", "<cstring>", "<iterator>", "<string_view>"}) {
+            out.line("#include {}", header);
+        }
+        out.blank();
+        for (std::string_view header :
+            {"\"Cursor.hpp\"", "\"JSON/Number.hpp\"", "\"Plugin.hpp\""}) {
+            out.line("#include {}", header);
+        }
+        out.blank();
+        out.line("using Blueprint::Cursor;");
+        out.line("using Blueprint::JSON::Number;");
+        out.blank();
+
+        out.line("static const char SCHEMA[] =");
+        for (std::size_t i = 0; i < schema.size(); i += 64) {
+            out.line("    {}{}", quote(schema.substr(i, 64)),
+                i + 64 >= schema.size() ? ";" : "");
+        }
+        out.blank();
+
+        std::string text = out.text() + _constants.text();
+        if (!_constants.text().empty()) {
+            text += '\n';
+        }
+        text += _lookups.text();
+
+        Output declarations;
+        for (std::size_t index : order) {
+            declarations.line("static bool node{}(Cursor &cursor);", index);
+        }
+        declarations.blank();
+
+        Output tail;
+        tail.line(
+            "static bool verify(const char *data, std::size_t size, "
+            "std::size_t depth)");
+        tail.line("{{");
+        tail.line("    Cursor cursor(std::string_view(data, size), depth);");
+        tail.blank();
+        tail.line("    return node{}(cursor) && cursor.done();",
+            _program.index(_program.root()));
+        tail.line("}}");
+        tail.blank();
+        tail.line("static const Blueprint::Plugin PLUGIN = {{");
+        tail.line("    .version = Blueprint::Plugin::VERSION,");
+        tail.line("    .schema = SCHEMA,");
+        tail.line("    .size = sizeof(SCHEMA) - 1,");
+        tail.line("    .verify = verify,");
+        tail.line("}};");
+        tail.blank();
+        tail.line("extern \"C\" BLUEPRINT_EXPORT const Blueprint::Plugin *{}()",
+            Blueprint::Plugin::ENTRY);
+        tail.line("{{");
+        tail.line("    return &PLUGIN;");
+        tail.line("}}");
+
+        return text + declarations.text() + _functions.text() + tail.text();
+    }
+};
+
+int main(int argc, char **argv)
+{
+    if (argc != 3) {
+        fmt::print(stderr, "Usage: blueprint_codegen <schema> <output.cpp>\n");
+        return 2;
+    }
+
+    Blueprint::Mapping mapping;
+    if (!mapping.open(argv[1])) {
+        fmt::print(stderr, "{}\n", mapping.getError());
+        return 1;
+    }
+
+    // A JSON schema saved to a file usually gains a final newline, which
+    // would no longer match the text compile_plugin is given
+    std::string_view schema = mapping.view();
+    if (!Blueprint::Reader::matches(schema)) {
+        std::size_t end = schema.find_last_not_of(" \t\n\r");
+        schema = schema.substr(0, end == std::string_view::npos ? 0 : end + 1);
+    }
+
+    Blueprint::Program program;
+    if (!program.load(schema)) {
+        fmt::print(stderr, "{}\n", program.getError());
+        return 1;
+    }
+
+    std::string source = Generator(program).source(schema);
+
+    std::FILE *file = std::fopen(argv[2], "wb");
+    if (file == nullptr) {
+        fmt::print(stderr, "Failed to open '{}'\n", argv[2]);
+        return 1;
+    }
+
+    bool written =
+        std::fwrite(source.data(), 1, source.size(), file) == source.size();
+    if (std::fclose(file) != 0 || !written) {
+        fmt::print(stderr, "Failed to write '{}'\n", argv[2]);
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,83 @@
+#ifndef __CONTEXT_HPP
+#define __CONTEXT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include "JSON/Document.hpp"
+#include "JSON/Value.hpp"
+#include "Program.hpp"
+#include "Stats.hpp"
+#include "Stream.hpp"
+#include "Validator.hpp"
+
+namespace Blueprint
+{
+    enum class Mode {
+        TREE,
+        STREAM,
+    };
+
+    // Scratch state of one thread of validation: the reusable document, the
+    // streaming validator and the error of the last call. Contexts are never
+    // shared, while the immutable Program they read may be used by any
+    // number of them at once.
+    class Context : public Validator {
+      public:
+        // Deepest nesting a handle accepts unless told otherwise
+        static constexpr std::size_t DEPTH = 1024;
+
+      private:
+        // Container being walked and the member read last
+        struct Frame {
+            const Program::Node *node;
+            const JSON::Value *value;
+            // Input offset where the container starts
+            std::size_t offset;
+            std::size_t index;
+            // Key table slot of the member, for error paths
+            std::size_t slot;
+        };
+
+        Mode _mode = Mode::TREE;
+        std::size_t _depth = DEPTH;
+        JSON::Document _document;
+        Stream _stream;
+        std::vector<Frame> _frames;
+        // Counters of every validation on this context, only kept when
+        // built with BLUEPRINT_STATS
+        Stats _totals = {};
+
+        bool handle(const Program &program, const JSON::Value &root);
+        // Records the path of a failure through the outermost depth
+        // frames, always false
+        bool trace(const Program &program, std::size_t depth);
+        // Validates a parsed tree, start is when parsing finished
+        bool walk(const Program &program, const JSON::Value &root,
+            std::uint64_t start);
+
+        static Scalar view(const JSON::Value &value);
+
+      public:
+        Context();
+
+        // The document, stream and validator point at the counters
+        Context(const Context &) = delete;
+        Context &operator=(const Context &) = delete;
+
+        // Tries the generated validator of the program first, if it has one
+        bool verify(const Program &program, std::string_view data);
+        // Validates a MessagePack document, always as a tree. Its strings
+        // are plain UTF-8 and escaped while read.
+        bool verifyPacked(const Program &program, std::string_view data);
+        void setMode(Mode mode);
+        // Deepest nesting of a document, 0 for no limit
+        void setDepth(std::size_t depth);
+        const Stats &getStats() const;
+        void resetStats();
+    };
+} // namespace Blueprint
+
+#endif /* __CONTEXT_HPP */
@@ -0,0 +1,309 @@
+#ifndef __CURSOR_HPP
+#define __CURSOR_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <string_view>
+
+#include "JSON/Number.hpp"
+
+namespace Blueprint
+{
+    // Scanner the validators of blueprint_codegen are built on. It reads
+    // the grammar of JSON::Lexer straight off the input, with no tokens and
+    // no errors, and is defined here so generated code inlines all of it.
+    // Rejecting more than the lexer is harmless, since the interpreter gets
+    // the final say, but it must never accept anything the lexer rejects.
+    class Cursor {
+      public:
+        enum class Numeral : std::uint8_t {
+            NONE,
+            // Plain integer of up to 18 digits, read inline
+            INTEGER,
+            // Anything else, read by JSON::Number::parse
+            NUMBER,
+        };
+
+      private:
+        // Containers nested deeper than this in a skipped value are rejected
+        static constexpr std::size_t SKIP = 64;
+
+        const char *_it;
+        const char *_end;
+        std::size_t _depth = 0;
+        std::size_t _limit;
+
+        static bool delimiter(char ch)
+        {
+            switch (ch) {
+                case ' ':
+                case '\t':
+                case '\n':
+                case '\r':
+                case '{':
+                case '}':
+                case '[':
+                case ']':
+                case ':':
+                case ',':
+                case '"': return true;
+                default: return false;
+            }
+        }
+
+        static bool numeric(char ch)
+        {
+            return (ch >= '0' && ch <= '9') || ch == '-' || ch == '+'
+                || ch == '.' || ch == 'e' || ch == 'E';
+        }
+
+        bool delimited(const char *it) const
+        {
+            return it == _end || delimiter(*it);
+        }
+
+        // Consumes a literal followed by a delimiter
+        bool word(std::string_view literal)
+        {
+            blank();
+            if (static_cast<std::size_t>(_end - _it) < literal.size()
+                || std::memcmp(_it, literal.data(), literal.size()) != 0
+                || !delimited(_it + literal.size())) {
+                return false;
+            }
+
+            _it += literal.size();
+            return true;
+        }
+
+        bool member()
+        {
+            std::string_view key;
+            return string(key) && take(':');
+        }
+
+      public:
+        // Depth is the deepest nesting accepted, 0 for no limit
+        Cursor(std::string_view data, std::size_t depth)
+            : _it(data.data()), _end(data.data() + data.size()), _limit(depth)
+        {
+        }
+
+        void blank()
+        {
+            while (_it != _end
+                && (*_it == ' ' || *_it == '\t' || *_it == '\n'
+                    || *_it == '\r')) {
+                ++_it;
+            }
+        }
+
+        // Next byte past whitespace without consuming it, 0 at the end
+        char peek()
+        {
+            blank();
+            return _it == _end ? '\0' : *_it;
+        }
+
+        bool take(char ch)
+        {
+            if (peek() != ch || _it == _end) {
+                return false;
+            }
+
+            ++_it;
+            return true;
+        }
+
+        // Reads the raw text of a string, which is never unescaped
+        bool string(std::string_view &text)
+        {
+            if (!take('"')) {
+                return false;
+            }
+
+            // A quote ends the string unless an odd run of backslashes
+            // escapes it
+            const char *quote = _it;
+            while (true) {
+                quote = static_cast<const char *>(
+                    std::memchr(quote, '"', _end - quote));
+                if (quote == nullptr) {
+                    return false;
+                }
+
+                const char *run = quote;
+                while (run != _it && run[-1] == '\\') {
+                    --run;
+                }
+
+                if ((quote - run) % 2 == 0) {
+                    break;
+                }
+
+                ++quote;
+            }
+
+            text = std::string_view(_it, quote - _it);
+            _it = quote + 1;
+
+            return true;
+        }
+
+        // Reads a number into integer when it is INTEGER, into number
+        // when it is NUMBER
+        Numeral number(std::int64_t &integer, JSON::Number &number)
+        {
+            blank();
+            const char *it = _it;
+            bool negative = it != _end && *it == '-';
+            if (negative) {
+                ++it;
+            }
+
+            const char *digits = it;
+            std::int64_t value = 0;
+            for (; it != _end && it - digits < 18 && *it >= '0' && *it <= '9';
+                ++it) {
+                value = value * 10 + (*it - '0');
+            }
+
+            if (it != digits && (it - digits == 1 || *digits != '0')
+                && delimited(it)) {
+                integer = negative ? -value : value;
+                _it = it;
+                return Numeral::INTEGER;
+            }
+
+            for (it = _it; it != _end && numeric(*it); ++it) {
+            }
+
+            if (it == _it || !delimited(it)) {
+                return Numeral::NONE;
+            }
+
+            std::optional<JSON::Number> parsed =
+                JSON::Number::parse(std::string_view(_it, it - _it));
+            if (!parsed.has_value()) {
+                return Numeral::NONE;
+            }
+
+            number = parsed.value();
+            _it = it;
+
+            return Numeral::NUMBER;
+        }
+
+        bool boolean(bool &value)
+        {
+            if (word("true")) {
+                value = true;
+                return true;
+            }
+
+            value = false;
+            return word("false");
+        }
+
+        bool null()
+        {
+            return word("null");
+        }
+
+        // Opens a container, false past the depth limit
+        bool enter(char open)
+        {
+            if (!take(open)) {
+                return false;
+            }
+
+            ++_depth;
+            return _limit == 0 || _depth <= _limit;
+        }
+
+        void leave()
+        {
+            --_depth;
+        }
+
+        // Steps over a value of any shape, only checking its syntax
+        bool skip()
+        {
+            char closers[SKIP];
+            std::size_t count = 0;
+
+            while (true) {
+                char ch = peek();
+                if (ch == '[' || ch == '{') {
+                    if (count == SKIP || !enter(ch)) {
+                        return false;
+                    }
+
+                    closers[count++] = ch == '[' ? ']' : '}';
+                    if (!take(closers[count - 1])) {
+                        if (ch == '{' && !member()) {
+                            return false;
+                        }
+                        continue;
+                    }
+
+                    leave();
+                    --count;
+                } else if (ch == '"') {
+                    std::string_view text;
+                    if (!string(text)) {
+                        return false;
+                    }
+                } else if (ch == 't' || ch == 'f') {
+                    bool value = false;
+                    if (!boolean(value)) {
+                        return false;
+                    }
+                } else if (ch == 'n') {
+                    if (!null()) {
+                        return false;
+                    }
+                } else {
+                    std::int64_t integer = 0;
+                    JSON::Number value;
+                    if (number(integer, value) == Numeral::NONE) {
+                        return false;
+                    }
+                }
+
+                // Closes every container the value completes
+                while (true) {
+                    if (count == 0) {
+                        return true;
+                    }
+
+                    if (take(',')) {
+                        break;
+                    }
+
+                    if (!take(closers[count - 1])) {
+                        return false;
+                    }
+
+                    leave();
+                    --count;
+                }
+
+                if (closers[count - 1] == '}' && !member()) {
+                    return false;
+                }
+            }
+        }
+
+        // Whether only whitespace is left
+        bool done()
+        {
+            blank();
+            return _it == _end;
+        }
+    };
+} // namespace Blueprint
+
+#endif /* __CURSOR_HPP */
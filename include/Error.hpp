@@ -0,0 +1,108 @@
+#ifndef __ERROR_HPP
+#define __ERROR_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "JSON/Kind.hpp"
+#include "JSON/Number.hpp"
+
+namespace Blueprint
+{
+    class Program;
+
+    // Category of the last failure
+    enum class Code : std::uint8_t {
+        NONE,
+        SYNTAX,
+        CONSTRAINT,
+    };
+
+    // What a validation failed on. Syntax reasons come first, everything
+    // from TYPE on is a constraint.
+    enum class Reason : std::uint8_t {
+        NONE,
+        UNEXPECTED_CHAR,
+        UNTERMINATED_STRING,
+        INVALID_NUMBER,
+        INVALID_LITERAL,
+        UNEXPECTED_TOKEN,
+        UNEXPECTED_END,
+        EXPECTED_KEY,
+        EXPECTED_COLON,
+        EXPECTED_SEPARATOR,
+        TRAILING_DATA,
+        TOO_LARGE,
+        TOO_DEEP,
+        TYPE,
+        MIN_VALUE,
+        MAX_VALUE,
+        MIN_LENGTH,
+        MAX_LENGTH,
+        ENUM,
+        VALUES,
+        REJECT,
+        REQUIRED,
+        SCALAR_ELEMENTS,
+        UNKNOWN_KEY,
+    };
+
+    // Step of a JSON Pointer, an array index or the slot of a field in the
+    // key table of an object node
+    struct Segment {
+        static constexpr std::uint32_t ELEMENT = UINT32_MAX;
+
+        std::uint32_t index;
+        // Object node holding the field, ELEMENT for an array index
+        std::uint32_t node;
+    };
+
+    // Failure kept as its reason and raw operands. It has the same size
+    // whatever the input, and text is only produced when asked for.
+    struct Error {
+        // Offset of a failure that cannot be tied to a byte of the input
+        static constexpr std::size_t NO_OFFSET = SIZE_MAX;
+        // Innermost segments kept of a deeper path
+        static constexpr std::size_t DEPTH = 16;
+        // Bytes kept of the offending token or key
+        static constexpr std::size_t TEXT = 32;
+
+        Reason reason = Reason::NONE;
+        JSON::Kind expected = JSON::Kind::NULL_VALUE;
+        JSON::Kind actual = JSON::Kind::NULL_VALUE;
+        std::uint8_t size = 0;
+        // Whether the text or the path were cut short
+        bool clipped = false;
+        bool deep = false;
+        std::uint8_t depth = 0;
+        char text[TEXT] = {};
+        JSON::Number value;
+        JSON::Number bound;
+        std::uint64_t length = 0;
+        std::uint64_t limit = 0;
+        std::uint64_t offset = NO_OFFSET;
+        // One-based, zero while the offset is unknown
+        std::uint64_t line = 0;
+        std::uint64_t column = 0;
+        Segment path[DEPTH] = {};
+
+        Code code() const;
+        void clear();
+        void setText(std::string_view text);
+        // Adds the next enclosing segment while walking out of the failing
+        // value, past DEPTH of them the outer ones are dropped
+        void push(Segment segment);
+        // Puts the pushed segments in JSON Pointer order
+        void reverse();
+        // Fills line and column from the offset within data
+        void locate(std::string_view data);
+
+        // Message, JSON Pointer and location. Field names are read from the
+        // program the failure came from, without it fields print as slots.
+        std::string format(const Program *program) const;
+    };
+} // namespace Blueprint
+
+#endif /* __ERROR_HPP */
@@ -0,0 +1,51 @@
+#ifndef __ARENA_HPP
+#define __ARENA_HPP
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Blueprint::JSON
+{
+    class Arena {
+      private:
+        struct Block {
+            std::unique_ptr<std::byte[]> data;
+            std::size_t size;
+        };
+
+        std::vector<Block> _blocks;
+        std::size_t _block = 0;
+        std::size_t _offset = 0;
+        std::size_t _capacity;
+        std::size_t _allocations = 0;
+
+        void grow(std::size_t size);
+
+      public:
+        Arena(std::size_t capacity = 64 * 1024);
+
+        void *allocate(std::size_t size, std::size_t alignment);
+        void reset();
+
+        std::size_t allocations() const;
+        std::size_t used() const;
+
+        template <typename T, typename... Args>
+        T *make(Args &&...args)
+        {
+            static_assert(std::is_trivially_destructible_v<T>,
+                "Arena objects are never destroyed");
+            static_assert(alignof(T) <= alignof(std::max_align_t),
+                "Arena blocks are only max_align_t aligned");
+
+            void *memory = allocate(sizeof(T), alignof(T));
+            return new (memory) T(std::forward<Args>(args)...);
+        }
+    };
+} // namespace Blueprint::JSON
+
+#endif /* __ARENA_HPP */
@@ -0,0 +1,92 @@
+#ifndef __DOCUMENT_HPP
+#define __DOCUMENT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+#include "Error.hpp"
+#include "JSON/Arena.hpp"
+#include "JSON/Kind.hpp"
+#include "JSON/Lexer.hpp"
+#include "JSON/Token.hpp"
+#include "JSON/Value.hpp"
+#include "Stats.hpp"
+
+namespace Blueprint::JSON
+{
+    // Strings and keys are views into the parsed input, which must outlive
+    // the document. MessagePack input is read into the same tree, its
+    // strings escaped into the text found between the quotes of their JSON
+    // form, as JSON.stringify would print it.
+    class Document {
+      private:
+        // Container open around the value being read
+        struct Frame {
+            // Stack index of its first child
+            std::size_t start;
+            // Input offset of the token or byte opening it
+            std::size_t offset;
+            // Children of a MessagePack container still to read, keys
+            // included
+            std::uint64_t remaining;
+            Kind kind;
+        };
+
+        Arena _arena;
+        Lexer _lexer;
+        std::vector<Value> _stack;
+        // Input offset of every value of the stack
+        std::vector<std::size_t> _starts;
+        std::size_t _root = 0;
+        std::vector<Frame> _frames;
+        Error _error;
+        // Offset of the last token read
+        std::size_t _offset = 0;
+        // Deepest nesting accepted, 0 for no limit
+        std::size_t _limit = 0;
+        Stats *_stats = nullptr;
+        // MessagePack input and the offset of its next byte
+        std::string_view _packed;
+        std::size_t _position = 0;
+
+        std::optional<Token> next();
+        bool parseValue(const Token &token);
+        // Pushes a value starting at the last token read
+        void push(Value value);
+        bool collapse(const Frame &frame);
+        bool open(Kind kind, std::uint64_t remaining);
+        // Records a failure at the last token read
+        Error &fail(Reason reason);
+
+        std::optional<std::string_view> take(std::size_t size);
+        std::optional<std::uint64_t> length(std::size_t size);
+        bool unpackValue();
+        // Map keys must be strings
+        bool unpackKey();
+        bool unpackString(std::size_t size);
+
+      public:
+        Document();
+
+        const Value *parse(std::string_view json);
+        const Value *unpack(std::string_view packed);
+        void clear();
+        // Input offset where the root of the last document starts
+        std::size_t offset() const;
+        // Input offset where a child of a container starts, keys of an
+        // object counted as children
+        static std::size_t offset(const Value &container, std::size_t index);
+        // Deepest nesting a document may have, 0 for no limit
+        void setDepth(std::size_t depth);
+        // Counters the tokens, values and depth of every parse are added to
+        void setStats(Stats *stats);
+
+        const Arena &arena() const;
+        const Error &getError() const;
+    };
+} // namespace Blueprint::JSON
+
+#endif /* __DOCUMENT_HPP */
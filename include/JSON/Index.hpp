@@ -0,0 +1,67 @@
+#ifndef __INDEX_HPP
+#define __INDEX_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include "Stats.hpp"
+
+namespace Blueprint::JSON
+{
+    // Classification masks of a 64-byte block, one bit per byte
+    struct Masks {
+        std::uint64_t structural;
+        std::uint64_t whitespace;
+        std::uint64_t quote;
+        std::uint64_t backslash;
+    };
+
+    // Structural index of a JSON input, built 64 bytes at a time over a
+    // bounded window. It yields, in order, the offset of every structural
+    // character, every unescaped quote and the first byte of every literal
+    // outside strings, so the lexer never has to scan whitespace or string
+    // contents itself.
+    class Index {
+      private:
+        std::string_view _json;
+        std::vector<std::size_t> _positions;
+        std::size_t _size = 0;
+        std::size_t _cursor = 0;
+        std::size_t _offset = 0;
+        std::uint64_t _string = 0;
+        std::uint64_t _escaped = 0;
+        std::uint64_t _scalar = 0;
+        Stats *_stats = nullptr;
+
+        void refill();
+        void classify(const char *block, std::size_t offset);
+
+      public:
+        static constexpr std::size_t BLOCK = 64;
+        static constexpr std::size_t WINDOW = 64 * BLOCK;
+
+        void reset(std::string_view json);
+        // Counters the indexing time is added to
+        void setStats(Stats *stats);
+
+        // Offset of the next position, or the input size once exhausted
+        std::size_t next()
+        {
+            while (_cursor == _size) {
+                if (_offset >= _json.size()) {
+                    return _json.size();
+                }
+
+                refill();
+            }
+
+            return _positions[_cursor++];
+        }
+
+        static const char *backend();
+    };
+} // namespace Blueprint::JSON
+
+#endif /* __INDEX_HPP */
@@ -0,0 +1,18 @@
+#ifndef __KIND_HPP
+#define __KIND_HPP
+
+#include <cstdint>
+
+namespace Blueprint::JSON
+{
+    enum class Kind : std::uint8_t {
+        NUMBER,
+        STRING,
+        BOOLEAN,
+        NULL_VALUE,
+        ARRAY,
+        OBJECT,
+    };
+} // namespace Blueprint::JSON
+
+#endif /* __KIND_HPP */
@@ -2,41 +2,46 @@
 #define __LEXER_HPP
 
 #include <cstddef>
-#include <fmt/core.h>
-#include <iterator>
 #include <optional>
+#include <string_view>
 
+#include "Error.hpp"
+#include "JSON/Index.hpp"
 #include "JSON/Token.hpp"
+#include "Stats.hpp"
 
 namespace Blueprint::JSON
 {
+    // Tokens are views into the input, which must outlive the lexer. Token
+    // boundaries come from the structural index, whitespace and string
+    // contents are never scanned byte by byte.
     class Lexer {
       private:
-        std::string _json;
-        std::string _error;
+        std::string_view _json;
+        Error _error;
         std::size_t _position = 0;
+        // Offset of the last token read, also when it failed
+        std::size_t _start = 0;
+        Index _index;
 
-        void skipWhitespace();
-        std::optional<Token> advanceAndReturn(
-            Type type, const std::string &value);
+        bool delimited();
+        std::optional<Token> advanceAndReturn(Type type);
         std::optional<Token> parseString();
         std::optional<Token> parseNumber();
         std::optional<Token> parseNull();
         std::optional<Token> parseBoolean();
-        const std::string getWord() const;
-
-        template <typename... Args>
-        void setError(fmt::format_string<Args...> fmt, Args &&...args)
-        {
-            auto it = std::back_inserter(_error);
-            fmt::format_to(it, fmt, std::forward<Args>(args)...);
-        }
+        std::string_view getWord() const;
+        Error &fail(Reason reason, std::size_t offset);
 
       public:
         Lexer() = default;
-        Lexer(const std::string &json);
+        Lexer(std::string_view json);
+        void reset(std::string_view json);
+        void setStats(Stats *stats);
         std::optional<Token> nextToken();
-        const std::string &getError() const;
+        std::size_t position() const;
+        std::size_t start() const;
+        const Error &getError() const;
     };
 } // namespace Blueprint::JSON
 
@@ -0,0 +1,54 @@
+#ifndef __NUMBER_HPP
+#define __NUMBER_HPP
+
+#include <compare>
+#include <cstdint>
+#include <fmt/core.h>
+#include <optional>
+#include <string_view>
+
+namespace Blueprint::JSON
+{
+    // Number parsed once from its literal. Integers that fit are kept as an
+    // exact int64, anything else as a correctly rounded double. Comparisons
+    // between the two representations are exact.
+    class Number {
+      private:
+        union {
+            std::int64_t _integer;
+            double _real;
+        };
+        bool _integral = true;
+
+      public:
+        Number();
+
+        static Number fromInteger(std::int64_t value);
+        static Number fromReal(double value);
+        static std::optional<Number> parse(std::string_view text);
+
+        bool integral() const;
+        std::int64_t integer() const;
+        double real() const;
+
+        std::partial_ordering operator<=>(const Number &other) const;
+        bool operator==(const Number &other) const;
+    };
+} // namespace Blueprint::JSON
+
+template <> struct fmt::formatter<Blueprint::JSON::Number> {
+    constexpr auto parse(fmt::format_parse_context &ctx)
+    {
+        return ctx.begin();
+    }
+
+    template <typename Context>
+    auto format(const Blueprint::JSON::Number &number, Context &ctx) const
+    {
+        return number.integral()
+            ? fmt::format_to(ctx.out(), "{}", number.integer())
+            : fmt::format_to(ctx.out(), "{}", number.real());
+    }
+};
+
+#endif /* __NUMBER_HPP */
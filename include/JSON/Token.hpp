@@ -1,7 +1,10 @@
 #ifndef __TOKEN_HPP
 #define __TOKEN_HPP
 
-#include <string>
+#include <cstddef>
+#include <string_view>
+
+#include "JSON/Number.hpp"
 
 namespace Blueprint::JSON
 {
@@ -22,16 +25,18 @@ namespace Blueprint::JSON
     class Token {
       private:
         Type _type;
-        std::string _data;
+        std::size_t _offset;
+        std::string_view _data;
+        Number _number;
 
       public:
-        Token(Type type, const std::string data);
-
-        Token(Token &&other) noexcept = default;
-        Token &operator=(Token &&other) noexcept = default;
+        Token(Type type, std::size_t offset, std::string_view data);
+        Token(std::size_t offset, std::string_view data, Number number);
 
         Type type() const;
-        const std::string &data() const;
+        std::size_t offset() const;
+        std::string_view data() const;
+        const Number &number() const;
     };
 } // namespace Blueprint::JSON
 
@@ -0,0 +1,53 @@
+#ifndef __VALUE_HPP
+#define __VALUE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include "JSON/Kind.hpp"
+#include "JSON/Number.hpp"
+
+namespace Blueprint::JSON
+{
+    class Value {
+      private:
+        union {
+            double _number;
+            std::int64_t _integer;
+            bool _boolean;
+            const char *_string;
+            const Value *_children;
+        };
+        std::uint32_t _size = 0;
+        Kind _kind = Kind::NULL_VALUE;
+        bool _integral = false;
+
+      public:
+        Value();
+
+        static Value fromNull();
+        static Value fromBoolean(bool value);
+        static Value fromNumber(double value);
+        static Value fromInteger(std::int64_t value);
+        static Value fromString(std::string_view value);
+        static Value fromArray(const Value *elements, std::uint32_t size);
+        static Value fromObject(const Value *members, std::uint32_t size);
+
+        Kind kind() const;
+        bool integral() const;
+        bool boolean() const;
+        double number() const;
+        std::int64_t integer() const;
+        Number toNumber() const;
+        std::string_view string() const;
+
+        std::size_t size() const;
+        const Value *children() const;
+        const Value *find(std::string_view key) const;
+    };
+
+    static_assert(sizeof(Value) <= 16, "Value must fit in 16 bytes");
+} // namespace Blueprint::JSON
+
+#endif /* __VALUE_HPP */
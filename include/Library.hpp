@@ -0,0 +1,36 @@
+#ifndef __LIBRARY_HPP
+#define __LIBRARY_HPP
+
+#include <string>
+
+#include "Plugin.hpp"
+
+namespace Blueprint
+{
+    // Plugin library loaded at run time and unloaded with this object. Its
+    // symbols are bound when it loads and kept local, so plugins built from
+    // different schemas never resolve to each other.
+    class Library {
+      private:
+        void *_handle = nullptr;
+        const Plugin *_plugin = nullptr;
+        std::string _error;
+
+        void close();
+
+      public:
+        Library() = default;
+        ~Library();
+
+        Library(const Library &) = delete;
+        Library &operator=(const Library &) = delete;
+
+        // Loads a library and checks the plugin it exports
+        bool open(const std::string &path);
+
+        const Plugin *plugin() const;
+        const std::string &getError() const;
+    };
+} // namespace Blueprint
+
+#endif /* __LIBRARY_HPP */
@@ -0,0 +1,35 @@
+#ifndef __MAPPING_HPP
+#define __MAPPING_HPP
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace Blueprint
+{
+    // Read-only view of a whole file mapped into memory. Pages are paged in
+    // on first touch and hinted for sequential access, so a file is read in
+    // place with a resident footprint bounded by the kernel page cache.
+    class Mapping {
+      private:
+        const char *_data = nullptr;
+        std::size_t _size = 0;
+        std::string _error;
+
+        void close();
+
+      public:
+        Mapping() = default;
+        ~Mapping();
+
+        Mapping(const Mapping &) = delete;
+        Mapping &operator=(const Mapping &) = delete;
+
+        bool open(const std::string &path);
+
+        std::string_view view() const;
+        const std::string &getError() const;
+    };
+} // namespace Blueprint
+
+#endif /* __MAPPING_HPP */
@@ -0,0 +1,36 @@
+#ifndef __PLUGIN_HPP
+#define __PLUGIN_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#ifdef _WIN32
+    #define BLUEPRINT_EXPORT __declspec(dllexport)
+#else
+    #define BLUEPRINT_EXPORT __attribute__((visibility("default")))
+#endif
+
+namespace Blueprint
+{
+    // Validator generated ahead of time by blueprint_codegen, exported by a
+    // plugin library through a function named ENTRY. It only answers
+    // whether a document is valid: anything it does not accept goes on to
+    // the interpreter, which has the final say and builds the error.
+    struct Plugin {
+        // Bumped whenever the layout or the contract of verify changes
+        static constexpr std::uint32_t VERSION = 1;
+        static constexpr const char *ENTRY = "blueprint_plugin";
+
+        using Entry = const Plugin *(*)();
+
+        std::uint32_t version;
+        // Schema the validator was generated from
+        const char *schema;
+        std::size_t size;
+        // Whether data is valid, depth is the deepest nesting accepted, 0
+        // for no limit. False is not a verdict, only a fallback.
+        bool (*verify)(const char *data, std::size_t size, std::size_t depth);
+    };
+} // namespace Blueprint
+
+#endif /* __PLUGIN_HPP */
@@ -0,0 +1,71 @@
+#ifndef __POOL_HPP
+#define __POOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace Blueprint
+{
+    // Work-stealing pool running index ranges. Every worker owns a queue of
+    // ranges, pops from its back and steals from the front of the others
+    // once it runs dry. The calling thread takes part as worker 0, so a pool
+    // of size N spawns N - 1 threads.
+    class Pool {
+      public:
+        using Task = std::function<void(
+            std::size_t worker, std::size_t begin, std::size_t end)>;
+
+      private:
+        struct Range {
+            std::size_t begin;
+            std::size_t end;
+        };
+
+        struct Queue {
+            std::mutex mutex;
+            std::deque<Range> ranges;
+        };
+
+        std::vector<std::thread> _threads;
+        std::vector<std::unique_ptr<Queue>> _queues;
+        std::mutex _mutex;
+        std::condition_variable _wake;
+        std::condition_variable _done;
+        const Task *_task = nullptr;
+        std::atomic<std::size_t> _pending = 0;
+        // First exception thrown by a range, the ranges left are skipped
+        std::exception_ptr _failure;
+        std::atomic<bool> _failed = false;
+        std::uint64_t _generation = 0;
+        bool _stop = false;
+
+        void loop(std::size_t worker);
+        void drain(std::size_t worker);
+        std::optional<Range> take(std::size_t worker);
+
+      public:
+        explicit Pool(std::size_t size);
+        ~Pool();
+
+        Pool(const Pool &) = delete;
+        Pool &operator=(const Pool &) = delete;
+
+        // Runs task over [0, count) in ranges of at most grain indices and
+        // blocks until all of them are done. Not reentrant. An exception
+        // thrown by task on any worker is rethrown here once all are done.
+        void run(std::size_t count, std::size_t grain, const Task &task);
+        std::size_t size() const;
+    };
+} // namespace Blueprint
+
+#endif /* __POOL_HPP */
@@ -0,0 +1,148 @@
+#ifndef __PROGRAM_HPP
+#define __PROGRAM_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <fmt/core.h>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "JSON/Kind.hpp"
+#include "JSON/Number.hpp"
+#include "JSON/Value.hpp"
+#include "Library.hpp"
+#include "Plugin.hpp"
+#include "Reader.hpp"
+#include "Set.hpp"
+#include "Table.hpp"
+
+namespace Blueprint
+{
+    class Program {
+      public:
+        using Kind = JSON::Kind;
+
+        struct KeyHash {
+            using is_transparent = void;
+
+            std::size_t operator()(std::string_view key) const
+            {
+                return std::hash<std::string_view>{}(key);
+            }
+        };
+
+        enum class Opcode : std::uint8_t {
+            MIN_VALUE,
+            MAX_VALUE,
+            MIN_LENGTH,
+            MAX_LENGTH,
+            ENUM,
+            VALUES,
+            REJECT,
+            REQUIRED,
+        };
+
+        // Constraint lowered to an opcode and its pre-parsed operand: a
+        // bound, a length or the index of a literal set of the node
+        struct Instruction {
+            Opcode opcode;
+            std::size_t operand = 0;
+            JSON::Number bound;
+        };
+
+        struct Node {
+            Kind kind;
+            // Run on the value itself, or when a container opens
+            std::vector<Instruction> checks;
+            // Run on every element of an array
+            std::vector<Instruction> elements;
+            // Run with the element count when a container closes
+            std::vector<Instruction> sizes;
+            std::vector<Set> sets;
+            std::size_t element = 0;
+            // Slot of every field name of an object, and its node by slot
+            Table keys;
+            std::vector<std::size_t> fields;
+            // Whether an object accepts keys it does not name
+            bool open = false;
+        };
+
+      private:
+        // Container whose fields are still being read
+        struct Frame {
+            std::size_t index;
+            std::size_t remaining;
+            // Keys of a binary object
+            std::vector<std::string_view> keys;
+            // Element schema of a JSON array, or the keys and field
+            // schemas of a JSON object, alternating
+            const JSON::Value *children = nullptr;
+        };
+
+        std::vector<Node> _nodes;
+        std::string _error;
+        mutable std::atomic<std::size_t> _references = 1;
+        // Library of the generated validator tried ahead of the nodes
+        std::unique_ptr<Library> _library;
+
+        // Builds a node from a JSON schema and finds its data, but lowers
+        // none of it
+        std::optional<std::size_t> shape(
+            const JSON::Value &schema, const JSON::Value *&data);
+        bool lower(const JSON::Value &root, std::size_t depth);
+        // Reads a node and the keys of an object, but none of its fields
+        std::optional<std::size_t> header(
+            Reader &reader, std::vector<std::string_view> &keys);
+        bool decode(Reader &reader, std::size_t depth);
+        // Operand of a binary constraint, a LIST fills members
+        std::optional<JSON::Value> literal(
+            Reader &reader, std::vector<JSON::Value> &members, bool list);
+        bool operand(
+            Node &node, std::string_view name, const JSON::Value &value);
+        std::optional<Set> literals(
+            std::string_view name, const JSON::Value &value);
+
+        template <typename... Args>
+        void setError(fmt::format_string<Args...> fmt, Args &&...args)
+        {
+            fmt::format_to(
+                std::back_inserter(_error), fmt, std::forward<Args>(args)...);
+        }
+
+      public:
+        // Loads a JSON schema, or a binary one when it starts with
+        // Reader::MAGIC. Containers nested deeper than depth are rejected,
+        // 0 for no limit.
+        bool load(std::string_view schema, std::size_t depth = 0);
+
+        const Node &root() const;
+        const Node &operator[](std::size_t index) const;
+        // Index of a node of this program
+        std::size_t index(const Node &node) const;
+        const std::string &getError() const;
+
+        // Hands over a library whose plugin was generated from the schema
+        // this program loaded
+        void attach(std::unique_ptr<Library> library);
+        // Generated validator of the schema, nullptr when there is none
+        const Plugin *plugin() const;
+
+        // A loaded program is never written again, so any number of threads
+        // may validate against it. Handles sharing it hold a reference each.
+        void retain() const;
+        // Drops a reference, true when it was the last one
+        bool release() const;
+
+        static std::optional<Kind> kind(std::string_view name);
+        static const char *name(Kind kind);
+    };
+} // namespace Blueprint
+
+#endif /* __PROGRAM_HPP */
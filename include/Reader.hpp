@@ -0,0 +1,63 @@
+#ifndef __READER_HPP
+#define __READER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+#include "JSON/Number.hpp"
+
+namespace Blueprint
+{
+    // Bounds-checked cursor over a binary schema. Every read fails instead
+    // of running past the end, and nothing is copied out of the input.
+    //
+    // A binary schema starts with MAGIC and the format version, then holds
+    // the root node. A node is its kind tag, a varint count of constraints
+    // and every constraint as a tag in the order of the TS constraint flags
+    // and its tagged operand. Arrays follow with their element node.
+    // Objects follow with a varint field count, the table of every key as a
+    // varint length and its bytes, then the node of every field in the
+    // same order.
+    class Reader {
+      public:
+        // Never the first byte of a JSON text
+        static constexpr std::uint8_t MAGIC = 0x00;
+        static constexpr std::uint8_t VERSION = 1;
+
+        // Tag ahead of every operand. A LIST is a varint count of tagged
+        // literals, a STRING a varint length and its bytes.
+        enum class Tag : std::uint8_t {
+            INTEGER,
+            REAL,
+            STRING,
+            FALSE,
+            TRUE,
+            NULL_VALUE,
+            LIST,
+        };
+
+      private:
+        std::string_view _data;
+        std::size_t _position = 0;
+
+      public:
+        explicit Reader(std::string_view data);
+
+        std::optional<std::uint8_t> byte();
+        // Unsigned LEB128 of at most ten bytes
+        std::optional<std::uint64_t> varint();
+        std::optional<std::string_view> bytes(std::size_t size);
+        // Zigzag varint after INTEGER, little-endian double after REAL
+        std::optional<JSON::Number> number(Tag tag);
+
+        std::size_t position() const;
+        bool done() const;
+
+        // Whether data is a binary schema rather than JSON text
+        static bool matches(std::string_view data);
+    };
+} // namespace Blueprint
+
+#endif /* __READER_HPP */
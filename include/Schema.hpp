@@ -1,62 +1,164 @@
 #ifndef __SCHEMA_HPP
 #define __SCHEMA_HPP
 
+#include <cstddef>
+#include <cstdint>
 #include <fmt/core.h>
-#include <functional>
 #include <iterator>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
 
-#include "JSON/Parser.hpp"
-#include "JSON/primitives/Array.hpp"
-#include "JSON/primitives/Object.hpp"
-#include "interfaces/IPrimitive.hpp"
+#include "Context.hpp"
+#include "Error.hpp"
+#include "Pool.hpp"
+#include "Program.hpp"
+#include "Stats.hpp"
+#include "Validator.hpp"
 
 namespace Blueprint
 {
-    using SchemaCallback =
-        std::function<bool(std::shared_ptr<Interfaces::IPrimitive>,
-            std::shared_ptr<JSON::Primitives::Object>)>;
+    // Failed record of an NDJSON buffer
+    struct Failure {
+        std::uint64_t record;
+        std::uint64_t offset;
+        Code code;
+        std::uint8_t reserved[7];
+    };
+
+    static_assert(sizeof(Failure) == 24, "Failure is read through the FFI");
+
+    // Outcome of a single validation, written by the v2 entry points. It
+    // locates the failure without formatting it, the message is only built
+    // when read through error(). Line and column are zero when unknown.
+    struct Verdict {
+        std::uint8_t valid;
+        Code code;
+        Reason reason;
+        std::uint8_t reserved[5];
+        std::uint64_t offset;
+        std::uint64_t line;
+        std::uint64_t column;
+    };
+
+    static_assert(sizeof(Verdict) == 32, "Verdict is read through the FFI");
+
+    // Outcome of an NDJSON buffer. Bit i of the bitmap is set when record i
+    // is valid. The arrays are owned by the handle and stay valid until its
+    // next NDJSON call.
+    struct Report {
+        std::uint64_t records;
+        std::uint64_t failed;
+        const std::uint8_t *bitmap;
+        const Failure *failures;
+    };
 
-    class Schema {
+    // Handle handed out through the FFI. It validates on its own context
+    // and spreads bulk calls over a pool of worker contexts. A handle is
+    // used by one thread at a time, programs can be shared between handles.
+    class Schema : public Validator {
       private:
-        std::string _error;
-        JSON::Parser _parser;
-        std::unordered_map<std::string, SchemaCallback> _callbacks;
-
-        bool handle(std::shared_ptr<JSON::Primitives::Object> schema,
-            std::shared_ptr<Interfaces::IPrimitive> data);
-        bool check(std::shared_ptr<JSON::Primitives::Array> constraints,
-            std::shared_ptr<Interfaces::IPrimitive> data);
-
-        bool minValue(std::shared_ptr<Interfaces::IPrimitive> schema,
-            std::shared_ptr<JSON::Primitives::Object> data);
-        bool maxValue(std::shared_ptr<Interfaces::IPrimitive> schema,
-            std::shared_ptr<JSON::Primitives::Object> data);
-        bool minLength(std::shared_ptr<Interfaces::IPrimitive> schema,
-            std::shared_ptr<JSON::Primitives::Object> data);
-        bool maxLength(std::shared_ptr<Interfaces::IPrimitive> schema,
-            std::shared_ptr<JSON::Primitives::Object> data);
-        bool enumValue(std::shared_ptr<Interfaces::IPrimitive> schema,
-            std::shared_ptr<JSON::Primitives::Object> data);
-        bool required(std::shared_ptr<Interfaces::IPrimitive> schema,
-            std::shared_ptr<JSON::Primitives::Object> data);
-        bool exactValue(std::shared_ptr<Interfaces::IPrimitive> schema,
-            std::shared_ptr<JSON::Primitives::Object> data);
-
-        template <typename T>
-        static std::shared_ptr<T> as(
-            std::shared_ptr<Interfaces::IPrimitive> primitive);
+        // Span of an NDJSON record and the outcome of its validation
+        struct Record {
+            std::size_t offset;
+            std::size_t size;
+            Code code;
+        };
+
+        // Failed document of a batch
+        struct Rejection {
+            std::size_t index;
+            Error error;
+            // Formatted on first read
+            mutable std::string message;
+        };
+
+        static constexpr std::size_t BATCH_GRAIN = 64;
+        static constexpr std::size_t LINES_GRAIN = 256;
+        // Workers allowed per core, whatever the thread count asked for
+        static constexpr std::size_t OVERSUBSCRIPTION = 8;
+
+        Mode _mode = Mode::TREE;
+        std::size_t _depth = Context::DEPTH;
+        Context _context;
+        std::size_t _threads = 0;
+        std::unique_ptr<Pool> _pool;
+        std::vector<std::unique_ptr<Context>> _workers;
+        // Counters of worker contexts dropped by a change of thread count
+        Stats _retired = {};
+        // Program of the last failure, held so its field names can still be
+        // read when the message is formatted
+        const Program *_program = nullptr;
+        // Text ahead of the failure: a summary, or the whole message of an
+        // error that is not tied to the input
+        std::string _message;
+        mutable std::string _text;
+        mutable bool _formatted = false;
+        // Failures of the last batch by worker, then merged in input order
+        std::vector<std::vector<Rejection>> _rejections;
+        std::vector<Rejection> _failures;
+        std::size_t _batch = 0;
+        std::vector<Record> _records;
+        std::vector<std::uint8_t> _bitmap;
+        std::vector<Failure> _lines;
+        Report _report = {
+            .records = 0, .failed = 0, .bitmap = nullptr, .failures = nullptr};
+
+        std::size_t workers(std::size_t count, std::size_t grain);
+        void parallel(
+            std::size_t count, std::size_t grain, const Pool::Task &task);
+        Context &worker(std::size_t index);
+        void reset();
+        void hold(const Program &program);
+        void drop();
 
         template <typename... Args>
         void setError(fmt::format_string<Args...> fmt, Args &&...args)
         {
-            fmt::format_to(
-                std::back_inserter(_error), fmt, std::forward<Args>(args)...);
+            fmt::format_to(std::back_inserter(_message), fmt,
+                std::forward<Args>(args)...);
         }
 
       public:
-        Schema();
-        bool verify(std::string schema, std::string data);
-        const std::string &getError() const;
+        Schema() = default;
+        ~Schema();
+
+        Schema(const Schema &) = delete;
+        Schema &operator=(const Schema &) = delete;
+
+        bool verify(std::string_view schema, std::string_view data);
+        bool verify(const Program &program, std::string_view data);
+        bool verifyPacked(const Program &program, std::string_view data);
+        bool verify(const Program &program, const char *const *documents,
+            const std::size_t *lengths, std::size_t count,
+            std::uint8_t *results);
+        // Validates a file in place through a read-only mapping, always as
+        // a stream
+        bool verifyFile(const Program &program, const std::string &path);
+        bool verifyLines(const Program &program, std::string_view data);
+        Program *compile(std::string_view schema);
+        // Loads a plugin library and compiles the schema its validator was
+        // generated from, which must be schema unless that is empty
+        Program *compilePlugin(
+            const std::string &path, std::string_view schema);
+        void setMode(Mode mode);
+        // Deepest nesting of a document, 0 for no limit
+        void setDepth(std::size_t depth);
+        std::size_t getDepth() const;
+        // Worker count of batch and NDJSON calls, 0 for one per core
+        void setThreads(std::size_t threads);
+        const Report &getReport() const;
+        // Counters of the handle context and every worker
+        Stats getStats() const;
+        void resetStats();
+        Verdict getVerdict(bool valid) const;
+
+        // Message of the last call, formatted on first read and valid until
+        // the next call
+        const std::string &getMessage() const;
+        // Message of a record of the last batch, empty when it passed
+        const std::string *getMessage(std::size_t index) const;
     };
 } // namespace Blueprint
 
@@ -0,0 +1,81 @@
+#ifndef __SESSION_HPP
+#define __SESSION_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "Error.hpp"
+#include "JSON/Lexer.hpp"
+#include "Program.hpp"
+#include "Schema.hpp"
+#include "Stream.hpp"
+
+namespace Blueprint
+{
+    // Validation of a document received in chunks. Each chunk is lexed as
+    // it arrives and its tokens go straight to a stream validator, so the
+    // chunk holding the offending byte is the one that fails. Only a token
+    // cut by the end of a chunk is copied, until the chunk completing it.
+    class Session {
+      private:
+        // Token carried over to the next chunk
+        enum class Pending : std::uint8_t {
+            NONE,
+            STRING,
+            // Number or literal, which only ends at a delimiter
+            WORD,
+        };
+
+        const Program &_program;
+        Stream _stream;
+        JSON::Lexer _lexer;
+        Error _error;
+        bool _failed = false;
+        std::string _carry;
+        Pending _pending = Pending::NONE;
+        // Whether the carried string ends with an unpaired backslash
+        bool _escaped = false;
+        // Offset of the first byte not yet consumed, where the carried
+        // token or the next chunk starts
+        std::size_t _base = 0;
+        // Newlines before the base and offset of the line it is on
+        std::uint64_t _lines = 0;
+        std::size_t _line = 0;
+        mutable std::string _message;
+        mutable bool _formatted = false;
+
+        // Lexes a buffer starting at the base. Unless it is the last one,
+        // a token running into its end is carried instead.
+        bool lex(std::string_view data, bool last);
+        // Moves bytes of the chunk into the carried token until it ends
+        bool resume(std::string_view &chunk);
+        // Lexes the carried token once it is complete
+        bool flush();
+        void carry(std::string_view data, std::size_t start, Pending pending);
+        // Moves the base past the first size bytes of data
+        void consume(std::string_view data, std::size_t size);
+        // Records a failure of a buffer starting at the base, always false
+        bool reject(std::string_view data, const Error &error);
+
+      public:
+        // The program is retained until the session is destroyed, depth
+        // is the deepest nesting accepted, 0 for no limit
+        Session(const Program &program, std::size_t depth);
+        ~Session();
+
+        Session(const Session &) = delete;
+        Session &operator=(const Session &) = delete;
+
+        // Validates the next chunk of the document, false once it failed
+        bool feed(std::string_view chunk);
+        // Checks that the document is complete
+        bool end();
+        Verdict getVerdict(bool valid) const;
+        // Message of the failure, formatted on first read
+        const std::string &getMessage() const;
+    };
+} // namespace Blueprint
+
+#endif /* __SESSION_HPP */
@@ -0,0 +1,44 @@
+#ifndef __SET_HPP
+#define __SET_HPP
+
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+#include "JSON/Kind.hpp"
+#include "JSON/Number.hpp"
+#include "Table.hpp"
+
+namespace Blueprint
+{
+    // Literal members of an ENUM or VALUES constraint, built once when the
+    // program is loaded. Strings live in a key table, numbers in a sorted
+    // array and booleans and null in flags, so a lookup never allocates.
+    class Set {
+      private:
+        // Numbers up to this count are scanned instead of bisected
+        static constexpr std::size_t SCAN = 8;
+
+        Table _strings;
+        std::vector<JSON::Number> _numbers;
+        bool _true = false;
+        bool _false = false;
+        bool _null = false;
+
+      public:
+        void insert(JSON::Kind kind, const JSON::Number &number,
+            std::string_view text);
+        // Builds the lookup tables, called once after the last insert
+        void seal();
+
+        bool contains(JSON::Kind kind, const JSON::Number &number,
+            std::string_view text) const;
+
+        // Members by kind, for generated validators
+        const Table &strings() const;
+        // Sorted and without repeats once sealed
+        const std::vector<JSON::Number> &numbers() const;
+    };
+} // namespace Blueprint
+
+#endif /* __SET_HPP */
@@ -0,0 +1,62 @@
+#ifndef __STATS_HPP
+#define __STATS_HPP
+
+#include <chrono>
+#include <cstdint>
+
+namespace Blueprint
+{
+    // Whether validations keep counters. Without BLUEPRINT_STATS every
+    // hook is discarded at compile time and reads return zeros.
+#ifdef BLUEPRINT_STATS
+    inline constexpr bool STATS = true;
+#else
+    inline constexpr bool STATS = false;
+#endif
+
+    // Counters of the validations run on a handle. Lexing is the time
+    // spent indexing the input, parsing and validating exclude it.
+    struct Stats {
+        std::uint64_t verifications;
+        // Input bytes scanned
+        std::uint64_t bytes;
+        std::uint64_t tokens;
+        // Document values built, zero in stream mode
+        std::uint64_t nodes;
+        // Constraint instructions evaluated
+        std::uint64_t constraints;
+        // Deepest nesting seen
+        std::uint64_t depth;
+        // Nanoseconds per phase
+        std::uint64_t lex;
+        std::uint64_t parse;
+        std::uint64_t validate;
+
+        // Adds the counters of another thread, keeping the deepest depth
+        void merge(const Stats &other)
+        {
+            verifications += other.verifications;
+            bytes += other.bytes;
+            tokens += other.tokens;
+            nodes += other.nodes;
+            constraints += other.constraints;
+            depth = depth > other.depth ? depth : other.depth;
+            lex += other.lex;
+            parse += other.parse;
+            validate += other.validate;
+        }
+
+        // Monotonic clock of the phase timers, in nanoseconds
+        static std::uint64_t now()
+        {
+            return static_cast<std::uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now().time_since_epoch())
+                    .count());
+        }
+    };
+
+    static_assert(sizeof(Stats) == 72, "Stats is read through the FFI");
+} // namespace Blueprint
+
+#endif /* __STATS_HPP */
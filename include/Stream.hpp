@@ -0,0 +1,86 @@
+#ifndef __STREAM_HPP
+#define __STREAM_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+#include "JSON/Lexer.hpp"
+#include "JSON/Token.hpp"
+#include "Program.hpp"
+#include "Validator.hpp"
+
+namespace Blueprint
+{
+    // Validates tokens as they are lexed, without building a document. The
+    // state between two tokens is explicit, so tokens can also be pushed
+    // one at a time as their input arrives.
+    class Stream : public Validator {
+      private:
+        struct Frame {
+            const Program::Node *node;
+            std::size_t size;
+            // Key table slot of the member being read, for error paths
+            std::size_t slot;
+        };
+
+        // What the next token must be
+        enum class State : std::uint8_t {
+            VALUE,
+            // First member or end of a container just opened
+            FIRST,
+            // First token of a member after a separator
+            MEMBER,
+            COLON,
+            // Separator or end after a member
+            NEXT,
+            // The root value is complete, only the end may follow
+            DONE,
+        };
+
+        const Program *_program = nullptr;
+        JSON::Lexer _lexer;
+        std::vector<Frame> _frames;
+        // Closing token of every container of a skipped value
+        std::vector<JSON::Type> _closers;
+        State _state = State::DONE;
+        // Node of the expected value
+        const Program::Node *_node = nullptr;
+        // Deepest nesting accepted, 0 for no limit
+        std::size_t _limit = 0;
+
+        std::optional<JSON::Token> next();
+        bool value(const JSON::Token &token);
+        // Checks the syntax only of a value no node describes
+        bool skip(const JSON::Token &token);
+        bool key(const JSON::Token &token);
+        // Starts the next member of the innermost container at its first
+        // token
+        bool member(const JSON::Token &token);
+        // Closes the innermost container
+        bool end();
+        // Checks the nesting of a container about to open
+        bool nest();
+        // Moves past a complete value
+        void after();
+        // Records the path of a constraint failure through the outermost
+        // depth frames, always false
+        bool trace(std::size_t depth);
+
+      public:
+        bool verify(const Program &program, std::string_view data);
+        // Starts a document whose tokens are then pushed through step
+        void begin(const Program &program);
+        // Consumes the next token of the document, false once it failed.
+        // END_OF_FILE checks that the document is complete.
+        bool step(const JSON::Token &token);
+        // Deepest nesting of a document, 0 for no limit
+        void setDepth(std::size_t depth);
+        // Counters the tokens and depth of every validation are added to
+        void setStats(Stats *stats);
+    };
+} // namespace Blueprint
+
+#endif /* __STREAM_HPP */
@@ -0,0 +1,65 @@
+#ifndef __TABLE_HPP
+#define __TABLE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Blueprint
+{
+    // Read-only map from a string to its insertion index, built once when
+    // the program is loaded. Every key is held as its first and last eight
+    // bytes, which spell out keys of up to 16 bytes exactly, so most
+    // comparisons are two word compares. A few keys are scanned in order,
+    // more go in an open-addressing table that is a perfect hash whenever a
+    // seed placing every key in its own slot is found.
+    class Table {
+      public:
+        static constexpr std::size_t NONE = SIZE_MAX;
+
+      private:
+        // Keys up to this count are scanned instead of hashed
+        static constexpr std::size_t LINEAR = 4;
+        static constexpr std::size_t SEEDS = 32;
+        static constexpr std::uint32_t EMPTY = UINT32_MAX;
+
+        struct Key {
+            std::uint64_t first;
+            std::uint64_t last;
+            std::uint32_t offset;
+            std::uint32_t size;
+            // Insertion index, EMPTY for a free slot
+            std::uint32_t index;
+        };
+
+        // Every key back to back, for the middle of keys over 16 bytes
+        std::string _bytes;
+        std::vector<Key> _keys;
+        std::vector<Key> _slots;
+        std::uint64_t _seed = 0;
+        std::size_t _mask = 0;
+        bool _perfect = false;
+
+        static Key split(std::string_view name);
+        static std::uint64_t hash(
+            const Key &key, std::string_view name, std::uint64_t seed);
+        bool matches(const Key &key, const Key &probe,
+            std::string_view name) const;
+        bool place(std::uint64_t seed, bool probe);
+
+      public:
+        // Adds a key under the next index, a repeated key keeps its first
+        std::size_t insert(std::string_view name);
+        // Builds the lookup structure, called once after the last insert
+        void seal();
+
+        std::size_t find(std::string_view name) const;
+        // Key inserted under index
+        std::string_view name(std::size_t index) const;
+        std::size_t size() const;
+    };
+} // namespace Blueprint
+
+#endif /* __TABLE_HPP */
@@ -0,0 +1,53 @@
+#ifndef __VALIDATOR_HPP
+#define __VALIDATOR_HPP
+
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+#include "Error.hpp"
+#include "JSON/Number.hpp"
+#include "Program.hpp"
+#include "Stats.hpp"
+
+namespace Blueprint
+{
+    struct Scalar {
+        Program::Kind kind;
+        JSON::Number number;
+        std::string_view text;
+    };
+
+    class Validator {
+      public:
+        // Offset of a failure that cannot be tied to a byte of the input
+        static constexpr std::size_t NO_OFFSET = Error::NO_OFFSET;
+
+      protected:
+        Error _error;
+        // Offset of the value being checked, NO_OFFSET when unknown
+        std::size_t _offset = NO_OFFSET;
+        Stats *_stats = nullptr;
+
+        // Records a failure at the value being checked
+        Error &fail(Reason reason);
+
+        // Evaluates lowered constraints, length is the string or element count
+        bool run(const Program::Node &node,
+            const std::vector<Program::Instruction> &code, const Scalar &value,
+            std::size_t length);
+        bool scalar(const Program::Node &node, const Scalar &value);
+        bool element(const Program::Node &node, const Scalar &value);
+        bool element(const Program::Node &node, Program::Kind kind);
+        bool open(const Program::Node &node, Program::Kind kind);
+        bool close(const Program::Node &node, std::size_t size);
+
+      public:
+        const Error &getError() const;
+        Code getCode() const;
+        // Input offset of the last failure, NO_OFFSET when unknown
+        std::size_t getOffset() const;
+    };
+} // namespace Blueprint
+
+#endif /* __VALIDATOR_HPP */
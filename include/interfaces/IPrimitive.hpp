@@ -1,16 +0,0 @@
-#ifndef __IPRIMITIVE_HPP
-#define __IPRIMITIVE_HPP
-
-#include <string>
-
-namespace Blueprint::Interfaces
-{
-    class IPrimitive {
-      public:
-        virtual ~IPrimitive() = default;
-        virtual std::string toString() const = 0;
-        virtual const std::string &getType() const = 0;
-    };
-} // namespace Blueprint::Interfaces
-
-#endif /* __IPRIMITIVE_HPP */
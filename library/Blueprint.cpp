@@ -1,4 +1,12 @@
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "Program.hpp"
 #include "Schema.hpp"
+#include "Session.hpp"
+#include "Stats.hpp"
 
 extern "C" const char *version(void)
 {
@@ -29,11 +37,273 @@ extern "C" bool verify(
     return blueprint->verify(schema, data);
 }
 
+extern "C" Blueprint::Program *compile(
+    Blueprint::Schema *blueprint, const char *schema)
+{
+    if (blueprint == nullptr) {
+        return nullptr;
+    }
+
+    return blueprint->compile(schema);
+}
+
+extern "C" bool verify_compiled(Blueprint::Schema *blueprint,
+    const Blueprint::Program *program, const char *data)
+{
+    if (blueprint == nullptr || program == nullptr) {
+        return false;
+    }
+
+    return blueprint->verify(*program, data);
+}
+
+extern "C" Blueprint::Program *compile_v2(
+    Blueprint::Schema *blueprint, const char *schema, std::size_t length)
+{
+    if (blueprint == nullptr || (schema == nullptr && length != 0)) {
+        return nullptr;
+    }
+
+    return blueprint->compile(std::string_view(schema, length));
+}
+
+extern "C" Blueprint::Program *compile_plugin(Blueprint::Schema *blueprint,
+    const char *path, const char *schema, std::size_t length)
+{
+    if (blueprint == nullptr || path == nullptr
+        || (schema == nullptr && length != 0)) {
+        return nullptr;
+    }
+
+    return blueprint->compilePlugin(path, std::string_view(schema, length));
+}
+
+extern "C" bool verify_v2(Blueprint::Schema *blueprint,
+    const Blueprint::Program *program, const char *data, std::size_t length,
+    Blueprint::Verdict *verdict)
+{
+    if (blueprint == nullptr || program == nullptr || verdict == nullptr) {
+        return false;
+    }
+
+    if (data == nullptr && length != 0) {
+        return false;
+    }
+
+    bool valid = blueprint->verify(*program, std::string_view(data, length));
+    *verdict = blueprint->getVerdict(valid);
+
+    return valid;
+}
+
+extern "C" bool verify_packed(Blueprint::Schema *blueprint,
+    const Blueprint::Program *program, const char *data, std::size_t length,
+    Blueprint::Verdict *verdict)
+{
+    if (blueprint == nullptr || program == nullptr || verdict == nullptr) {
+        return false;
+    }
+
+    if (data == nullptr && length != 0) {
+        return false;
+    }
+
+    bool valid =
+        blueprint->verifyPacked(*program, std::string_view(data, length));
+    *verdict = blueprint->getVerdict(valid);
+
+    return valid;
+}
+
+extern "C" Blueprint::Session *verify_begin(
+    Blueprint::Schema *blueprint, const Blueprint::Program *program)
+{
+    if (blueprint == nullptr || program == nullptr) {
+        return nullptr;
+    }
+
+    return new (std::nothrow)
+        Blueprint::Session(*program, blueprint->getDepth());
+}
+
+extern "C" bool verify_feed(Blueprint::Session *session, const char *data,
+    std::size_t length, Blueprint::Verdict *verdict)
+{
+    if (session == nullptr || verdict == nullptr) {
+        return false;
+    }
+
+    if (data == nullptr && length != 0) {
+        return false;
+    }
+
+    bool valid = session->feed(std::string_view(data, length));
+    *verdict = session->getVerdict(valid);
+
+    return valid;
+}
+
+extern "C" bool verify_end(
+    Blueprint::Session *session, Blueprint::Verdict *verdict)
+{
+    if (session == nullptr || verdict == nullptr) {
+        return false;
+    }
+
+    bool valid = session->end();
+    *verdict = session->getVerdict(valid);
+
+    return valid;
+}
+
+extern "C" const char *session_error(Blueprint::Session *session)
+{
+    if (session == nullptr) {
+        return "'session_error' received a nullptr";
+    }
+
+    return session->getMessage().c_str();
+}
+
+extern "C" void session_destroy(Blueprint::Session *session)
+{
+    if (session == nullptr) {
+        return;
+    }
+
+    delete session;
+}
+
+extern "C" bool verify_batch(Blueprint::Schema *blueprint,
+    const Blueprint::Program *program, const char *const *documents,
+    const std::size_t *lengths, std::size_t count, uint8_t *results)
+{
+    if (blueprint == nullptr || program == nullptr) {
+        return false;
+    }
+
+    if (count != 0
+        && (documents == nullptr || lengths == nullptr || results == nullptr)) {
+        return false;
+    }
+
+    return blueprint->verify(*program, documents, lengths, count, results);
+}
+
+extern "C" const char *batch_error(
+    Blueprint::Schema *blueprint, std::size_t index)
+{
+    if (blueprint == nullptr) {
+        return nullptr;
+    }
+
+    const std::string *error = blueprint->getMessage(index);
+
+    return error == nullptr ? nullptr : error->c_str();
+}
+
+extern "C" bool verify_lines(Blueprint::Schema *blueprint,
+    const Blueprint::Program *program, const char *data, std::size_t length,
+    Blueprint::Report *report)
+{
+    if (blueprint == nullptr || program == nullptr || report == nullptr) {
+        return false;
+    }
+
+    if (data == nullptr && length != 0) {
+        return false;
+    }
+
+    bool valid =
+        blueprint->verifyLines(*program, std::string_view(data, length));
+    *report = blueprint->getReport();
+
+    return valid;
+}
+
+extern "C" bool verify_file(Blueprint::Schema *blueprint,
+    const Blueprint::Program *program, const char *path)
+{
+    if (blueprint == nullptr || program == nullptr || path == nullptr) {
+        return false;
+    }
+
+    return blueprint->verifyFile(*program, path);
+}
+
+extern "C" bool stats(Blueprint::Schema *blueprint, Blueprint::Stats *stats)
+{
+    if (blueprint == nullptr || stats == nullptr) {
+        return false;
+    }
+
+    *stats = blueprint->getStats();
+
+    return Blueprint::STATS;
+}
+
+extern "C" void reset_stats(Blueprint::Schema *blueprint)
+{
+    if (blueprint == nullptr) {
+        return;
+    }
+
+    blueprint->resetStats();
+}
+
+extern "C" Blueprint::Program *retain(Blueprint::Program *program)
+{
+    if (program == nullptr) {
+        return nullptr;
+    }
+
+    program->retain();
+
+    return program;
+}
+
+extern "C" void release(Blueprint::Program *program)
+{
+    if (program == nullptr || !program->release()) {
+        return;
+    }
+
+    delete program;
+}
+
+extern "C" void set_mode(Blueprint::Schema *blueprint, uint8_t mode)
+{
+    if (blueprint == nullptr
+        || mode > static_cast<uint8_t>(Blueprint::Mode::STREAM)) {
+        return;
+    }
+
+    blueprint->setMode(static_cast<Blueprint::Mode>(mode));
+}
+
+extern "C" void set_depth(Blueprint::Schema *blueprint, uint32_t depth)
+{
+    if (blueprint == nullptr) {
+        return;
+    }
+
+    blueprint->setDepth(depth);
+}
+
+extern "C" void set_threads(Blueprint::Schema *blueprint, uint32_t threads)
+{
+    if (blueprint == nullptr) {
+        return;
+    }
+
+    blueprint->setThreads(threads);
+}
+
 extern "C" const char *error(Blueprint::Schema *blueprint)
 {
     if (blueprint == nullptr) {
         return "'error' received a nullptr";
     }
 
-    return blueprint->getError().c_str();
+    return blueprint->getMessage().c_str();
 }
@@ -0,0 +1,264 @@
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include "Context.hpp"
+#include "Error.hpp"
+#include "JSON/Value.hpp"
+#include "Plugin.hpp"
+#include "Program.hpp"
+
+Blueprint::Context::Context()
+{
+    _stats = &_totals;
+    _stream.setStats(&_totals);
+    _document.setStats(&_totals);
+    setDepth(DEPTH);
+}
+
+bool Blueprint::Context::verify(const Program &program, std::string_view data)
+{
+    _error.clear();
+
+    // Lexing is timed by the index, the phases exclude it
+    std::uint64_t start = 0;
+    std::uint64_t lexed = 0;
+    if constexpr (STATS) {
+        ++_totals.verifications;
+        _totals.bytes += data.size();
+        start = Stats::now();
+        lexed = _totals.lex;
+    }
+
+    // A generated validator accepts most documents alone, the rest are
+    // left to the nodes, which reject them with a located error. Strings
+    // and containers past 32 bits cannot occur below that size.
+    const Plugin *plugin = program.plugin();
+    if (plugin != nullptr && data.size() <= UINT32_MAX
+        && plugin->verify(data.data(), data.size(), _depth)) {
+        if constexpr (STATS) {
+            _totals.validate += Stats::now() - start;
+        }
+
+        return true;
+    }
+
+    if (_mode == Mode::STREAM) {
+        bool valid = _stream.verify(program, data);
+        if constexpr (STATS) {
+            _totals.validate += Stats::now() - start - (_totals.lex - lexed);
+        }
+
+        if (!valid) {
+            _error = _stream.getError();
+            _error.locate(data);
+        }
+
+        return valid;
+    }
+
+    const JSON::Value *root = _document.parse(data);
+    if constexpr (STATS) {
+        std::uint64_t parsed = Stats::now();
+        _totals.parse += parsed - start - (_totals.lex - lexed);
+        start = parsed;
+    }
+
+    if (root == nullptr) {
+        _error = _document.getError();
+        _error.locate(data);
+        return false;
+    }
+
+    bool valid = walk(program, *root, start);
+    if (!valid) {
+        _error.locate(data);
+    }
+
+    return valid;
+}
+
+bool Blueprint::Context::verifyPacked(
+    const Program &program, std::string_view data)
+{
+    _error.clear();
+
+    std::uint64_t start = 0;
+    if constexpr (STATS) {
+        ++_totals.verifications;
+        _totals.bytes += data.size();
+        start = Stats::now();
+    }
+
+    const JSON::Value *root = _document.unpack(data);
+    if constexpr (STATS) {
+        std::uint64_t parsed = Stats::now();
+        _totals.parse += parsed - start;
+        start = parsed;
+    }
+
+    // Binary input has no lines, failures only carry their offset
+    if (root == nullptr) {
+        _error = _document.getError();
+        return false;
+    }
+
+    return walk(program, *root, start);
+}
+
+bool Blueprint::Context::walk(
+    const Program &program, const JSON::Value &root, std::uint64_t start)
+{
+    bool valid = handle(program, root);
+    _document.clear();
+    if constexpr (STATS) {
+        _totals.validate += Stats::now() - start;
+    }
+
+    return valid;
+}
+
+void Blueprint::Context::setMode(Mode mode)
+{
+    _mode = mode;
+}
+
+void Blueprint::Context::setDepth(std::size_t depth)
+{
+    _depth = depth;
+    _document.setDepth(depth);
+    _stream.setDepth(depth);
+}
+
+const Blueprint::Stats &Blueprint::Context::getStats() const
+{
+    return _totals;
+}
+
+void Blueprint::Context::resetStats()
+{
+    _totals = {};
+}
+
+bool Blueprint::Context::handle(
+    const Program &program, const JSON::Value &root)
+{
+    _frames.clear();
+    const Program::Node *node = &program.root();
+    const JSON::Value *value = &root;
+    // Failures are placed where the value being checked starts
+    _offset = _document.offset();
+
+    while (true) {
+        if (value->kind() == JSON::Kind::ARRAY
+            || value->kind() == JSON::Kind::OBJECT) {
+            if (!open(*node, value->kind())) {
+                return trace(program, _frames.size());
+            }
+
+            _frames.push_back({.node = node,
+                .value = value,
+                .offset = _offset,
+                .index = 0,
+                .slot = 0});
+        } else if (!scalar(*node, Context::view(*value))) {
+            return trace(program, _frames.size());
+        }
+
+        // Finds the next value, closing every container it completes
+        value = nullptr;
+        while (value == nullptr) {
+            if (_frames.empty()) {
+                return true;
+            }
+
+            Frame &frame = _frames.back();
+            const JSON::Value *children = frame.value->children();
+
+            if (frame.value->kind() == JSON::Kind::ARRAY) {
+                if (frame.index == frame.value->size()) {
+                    _offset = frame.offset;
+                    if (!close(*frame.node, frame.index)) {
+                        return trace(program, _frames.size() - 1);
+                    }
+
+                    _frames.pop_back();
+                    continue;
+                }
+
+                _offset = JSON::Document::offset(*frame.value, frame.index);
+                const JSON::Value &element = children[frame.index++];
+                bool member = element.kind() == JSON::Kind::ARRAY
+                        || element.kind() == JSON::Kind::OBJECT
+                    ? this->element(*frame.node, element.kind())
+                    : this->element(*frame.node, Context::view(element));
+                if (!member) {
+                    return trace(program, _frames.size());
+                }
+
+                node = &program[frame.node->element];
+                value = &element;
+                continue;
+            }
+
+            while (value == nullptr && frame.index < frame.value->size()) {
+                std::size_t i = frame.index++;
+                std::string_view key = children[i * 2].string();
+                std::size_t slot = frame.node->keys.find(key);
+                if (slot == Table::NONE) {
+                    if (frame.node->open) {
+                        continue;
+                    }
+
+                    _offset = JSON::Document::offset(*frame.value, i * 2);
+                    fail(Reason::UNKNOWN_KEY).setText(key);
+                    return trace(program, _frames.size() - 1);
+                }
+
+                frame.slot = slot;
+                node = &program[frame.node->fields[slot]];
+                value = &children[i * 2 + 1];
+                _offset = JSON::Document::offset(*frame.value, i * 2 + 1);
+            }
+
+            if (value == nullptr) {
+                _frames.pop_back();
+            }
+        }
+    }
+}
+
+bool Blueprint::Context::trace(const Program &program, std::size_t depth)
+{
+    for (std::size_t i = depth; i-- > 0;) {
+        const Frame &frame = _frames[i];
+        if (frame.value->kind() == JSON::Kind::ARRAY) {
+            _error.push({.index = static_cast<std::uint32_t>(frame.index - 1),
+                .node = Segment::ELEMENT});
+        } else {
+            _error.push({.index = static_cast<std::uint32_t>(frame.slot),
+                .node = static_cast<std::uint32_t>(
+                    program.index(*frame.node))});
+        }
+    }
+
+    _error.reverse();
+
+    return false;
+}
+
+Blueprint::Scalar Blueprint::Context::view(const JSON::Value &value)
+{
+    Scalar scalar = {.kind = value.kind(), .number = {}, .text = "null"};
+
+    switch (value.kind()) {
+        case JSON::Kind::NUMBER: scalar.number = value.toNumber(); break;
+        case JSON::Kind::STRING: scalar.text = value.string(); break;
+        case JSON::Kind::BOOLEAN:
+            scalar.text = value.boolean() ? "true" : "false";
+            break;
+        default: break;
+    }
+
+    return scalar;
+}
@@ -0,0 +1,208 @@
+#include <algorithm>
+#include <cstring>
+#include <fmt/core.h>
+#include <iterator>
+#include <string>
+#include <string_view>
+
+#include "Error.hpp"
+#include "Program.hpp"
+
+// Writes a JSON Pointer reference token, escaping '~' and '/'
+static void escape(std::string &out, std::string_view name)
+{
+    for (char ch : name) {
+        switch (ch) {
+            case '~': out += "~0"; break;
+            case '/': out += "~1"; break;
+            default: out += ch; break;
+        }
+    }
+}
+
+static void describe(std::string &out, const Blueprint::Error &error)
+{
+    using Blueprint::Program;
+    using Blueprint::Reason;
+    using Kind = Blueprint::JSON::Kind;
+
+    auto it = std::back_inserter(out);
+    std::string_view text(error.text, error.size);
+    std::string_view more = error.clipped ? "..." : "";
+    const char *expected = Program::name(error.expected);
+    const char *actual = Program::name(error.actual);
+
+    switch (error.reason) {
+        case Reason::NONE: break;
+        case Reason::UNEXPECTED_CHAR:
+            fmt::format_to(it, "Unexpected char '{}'", text);
+            break;
+        case Reason::UNTERMINATED_STRING:
+            fmt::format_to(it, "Expected '\"'");
+            break;
+        case Reason::INVALID_NUMBER:
+            fmt::format_to(it, "Invalid number '{}{}'", text, more);
+            break;
+        case Reason::INVALID_LITERAL:
+            fmt::format_to(it, "Expected {}, got '{}{}'",
+                error.expected == Kind::BOOLEAN ? "'true' or 'false'"
+                                                : "'null'",
+                text, more);
+            break;
+        case Reason::UNEXPECTED_TOKEN:
+            fmt::format_to(it, "Unexpected token '{}{}'", text, more);
+            break;
+        case Reason::UNEXPECTED_END:
+            fmt::format_to(it, "Unexpected end of file");
+            break;
+        case Reason::EXPECTED_KEY:
+            fmt::format_to(it, "Expected string, got '{}{}'", text, more);
+            break;
+        case Reason::EXPECTED_COLON:
+            fmt::format_to(it, "Expected colon, got '{}{}'", text, more);
+            break;
+        case Reason::EXPECTED_SEPARATOR:
+            fmt::format_to(it, "Expected ',' or '{}', got '{}{}'",
+                error.expected == Kind::OBJECT ? "}" : "]", text, more);
+            break;
+        case Reason::TRAILING_DATA:
+            fmt::format_to(
+                it, "Unexpected token '{}{}' after value", text, more);
+            break;
+        case Reason::TOO_LARGE:
+            if (error.expected == Kind::STRING) {
+                fmt::format_to(
+                    it, "String of {} bytes is too long", error.length);
+            } else {
+                fmt::format_to(it, "Container of {} elements is too large",
+                    error.length);
+            }
+            break;
+        case Reason::TOO_DEEP:
+            fmt::format_to(it, "Nesting deeper than {} levels", error.limit);
+            break;
+        case Reason::TYPE:
+            fmt::format_to(it, "Expected '{}', got '{}'", expected, actual);
+            break;
+        case Reason::MIN_VALUE:
+            fmt::format_to(it, "Value '{}' is less than '{}'", error.value,
+                error.bound);
+            break;
+        case Reason::MAX_VALUE:
+            fmt::format_to(it, "Value '{}' is greater than '{}'", error.value,
+                error.bound);
+            break;
+        case Reason::MIN_LENGTH:
+        case Reason::MAX_LENGTH:
+            fmt::format_to(it, "{} size expected {}{}, got {}",
+                error.reason == Reason::MIN_LENGTH ? "Minimum" : "Maximum",
+                error.limit, error.expected == Kind::ARRAY ? " elements" : "",
+                error.length);
+            break;
+        case Reason::ENUM:
+            fmt::format_to(it, "Value '{}{}' not in ENUM", text, more);
+            break;
+        case Reason::VALUES:
+            if (error.actual == Kind::NUMBER) {
+                fmt::format_to(it, "Value {} not in VALUES", error.value);
+            } else {
+                fmt::format_to(it, "Value '{}{}' not in VALUES", text, more);
+            }
+            break;
+        case Reason::REJECT:
+            fmt::format_to(it, "Value of type '{}' not in ENUM", actual);
+            break;
+        case Reason::REQUIRED:
+            fmt::format_to(it, "REQUIRED not implemented");
+            break;
+        case Reason::SCALAR_ELEMENTS:
+            fmt::format_to(
+                it, "VALUES expects scalar elements, got '{}'", actual);
+            break;
+        case Reason::UNKNOWN_KEY:
+            fmt::format_to(it, "Unknown key '{}{}'", text, more);
+            break;
+    }
+}
+
+Blueprint::Code Blueprint::Error::code() const
+{
+    if (reason == Reason::NONE) {
+        return Code::NONE;
+    }
+
+    return reason < Reason::TYPE ? Code::SYNTAX : Code::CONSTRAINT;
+}
+
+void Blueprint::Error::clear()
+{
+    // Operands are only ever written along with a reason, so an error
+    // without one is already clear
+    if (reason != Reason::NONE) {
+        *this = Error();
+    }
+}
+
+void Blueprint::Error::setText(std::string_view text)
+{
+    size = static_cast<std::uint8_t>(std::min(text.size(), TEXT));
+    clipped = text.size() > TEXT;
+    if (size != 0) {
+        std::memcpy(this->text, text.data(), size);
+    }
+}
+
+void Blueprint::Error::push(Segment segment)
+{
+    if (depth == DEPTH) {
+        deep = true;
+        return;
+    }
+
+    path[depth++] = segment;
+}
+
+void Blueprint::Error::reverse()
+{
+    std::reverse(path, path + depth);
+}
+
+void Blueprint::Error::locate(std::string_view data)
+{
+    if (offset == NO_OFFSET || offset > data.size()) {
+        return;
+    }
+
+    std::string_view head = data.substr(0, offset);
+    std::size_t newline = head.rfind('\n');
+
+    line = 1 + std::count(head.begin(), head.end(), '\n');
+    column = newline == std::string_view::npos ? offset + 1
+                                               : offset - newline;
+}
+
+std::string Blueprint::Error::format(const Program *program) const
+{
+    std::string out;
+    describe(out, *this);
+
+    if (depth != 0) {
+        out += deep ? " at /..." : " at ";
+        for (std::size_t i = 0; i < depth; ++i) {
+            const Segment &segment = path[i];
+            out += '/';
+            if (segment.node == Segment::ELEMENT || program == nullptr) {
+                out += std::to_string(segment.index);
+            } else {
+                escape(out, (*program)[segment.node].keys.name(segment.index));
+            }
+        }
+    }
+
+    if (line != 0) {
+        fmt::format_to(std::back_inserter(out), " (line {}, column {})", line,
+            column);
+    }
+
+    return out;
+}
@@ -0,0 +1,63 @@
+#include <algorithm>
+
+#include "JSON/Arena.hpp"
+
+Blueprint::JSON::Arena::Arena(std::size_t capacity) : _capacity(capacity)
+{
+}
+
+void Blueprint::JSON::Arena::grow(std::size_t size)
+{
+    while (++_block < _blocks.size()) {
+        if (_blocks[_block].size >= size) {
+            _offset = 0;
+            return;
+        }
+    }
+
+    std::size_t capacity = _blocks.empty()
+        ? _capacity
+        : std::max(_blocks.back().size * 2, _capacity);
+    capacity = std::max(capacity, size);
+
+    _blocks.push_back({std::make_unique<std::byte[]>(capacity), capacity});
+    _block = _blocks.size() - 1;
+    _offset = 0;
+    ++_allocations;
+}
+
+void *Blueprint::JSON::Arena::allocate(
+    std::size_t size, std::size_t alignment)
+{
+    std::size_t offset = (_offset + alignment - 1) & ~(alignment - 1);
+
+    if (_blocks.empty() || offset + size > _blocks[_block].size) {
+        grow(size);
+        offset = 0;
+    }
+
+    _offset = offset + size;
+
+    return _blocks[_block].data.get() + offset;
+}
+
+void Blueprint::JSON::Arena::reset()
+{
+    _block = 0;
+    _offset = 0;
+}
+
+std::size_t Blueprint::JSON::Arena::allocations() const
+{
+    return _allocations;
+}
+
+std::size_t Blueprint::JSON::Arena::used() const
+{
+    std::size_t used = _offset;
+    for (std::size_t i = 0; i < _block && i < _blocks.size(); ++i) {
+        used += _blocks[i].size;
+    }
+
+    return used;
+}
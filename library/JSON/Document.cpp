@@ -0,0 +1,614 @@
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <string_view>
+
+#include "Error.hpp"
+#include "JSON/Document.hpp"
+#include "JSON/Lexer.hpp"
+#include "JSON/Token.hpp"
+#include "JSON/Value.hpp"
+
+// Big-endian unsigned integer of at most eight bytes
+static std::uint64_t big(std::string_view bytes)
+{
+    std::uint64_t value = 0;
+    for (char byte : bytes) {
+        value = value << 8 | static_cast<std::uint8_t>(byte);
+    }
+
+    return value;
+}
+
+// Whether a token starts an object or array
+static bool opens(Blueprint::JSON::Type type)
+{
+    return type == Blueprint::JSON::Type::OBJECT_START
+        || type == Blueprint::JSON::Type::ARRAY_START;
+}
+
+// Token closing a container of the kind
+static Blueprint::JSON::Type closer(Blueprint::JSON::Kind kind)
+{
+    return kind == Blueprint::JSON::Kind::OBJECT
+        ? Blueprint::JSON::Type::OBJECT_END
+        : Blueprint::JSON::Type::ARRAY_END;
+}
+
+// Whether a MessagePack type byte starts a string
+static bool key(std::uint8_t tag)
+{
+    return (tag >= 0xa0 && tag <= 0xbf) || (tag >= 0xd9 && tag <= 0xdb);
+}
+
+// Bytes a character takes inside a JSON string, escaped as JSON.stringify
+// does
+static std::size_t escaped(char ch)
+{
+    switch (ch) {
+        case '"':
+        case '\\':
+        case '\b':
+        case '\f':
+        case '\n':
+        case '\r':
+        case '\t': return 2;
+        default: return static_cast<std::uint8_t>(ch) < 0x20 ? 6 : 1;
+    }
+}
+
+// Names an offending MessagePack type byte, as in "0xc1"
+static void marker(Blueprint::Error &error, char byte)
+{
+    static constexpr char DIGITS[] = "0123456789abcdef";
+    auto value = static_cast<std::uint8_t>(byte);
+    const char text[] = {'0', 'x', DIGITS[value >> 4], DIGITS[value & 0x0f]};
+
+    error.setText(std::string_view(text, sizeof(text)));
+}
+
+Blueprint::JSON::Document::Document()
+{
+    _frames.reserve(64);
+}
+
+const Blueprint::JSON::Value *Blueprint::JSON::Document::parse(
+    std::string_view json)
+{
+    _arena.reset();
+    _stack.clear();
+    _starts.clear();
+    _frames.clear();
+    _error.clear();
+    _offset = 0;
+    _lexer.reset(json);
+
+    std::optional<Token> token = next();
+
+    while (token.has_value()) {
+        // Whether the token may start the first member of a container
+        bool first = opens(token->type());
+        if (first) {
+            Kind kind = token->type() == Type::OBJECT_START ? Kind::OBJECT
+                                                             : Kind::ARRAY;
+            if constexpr (STATS) {
+                if (_stats != nullptr) {
+                    ++_stats->nodes;
+                }
+            }
+            if (!open(kind, 0)) {
+                return nullptr;
+            }
+        } else if (!parseValue(token.value())) {
+            return nullptr;
+        }
+
+        token = next();
+
+        // Closes every container the token ends and reads scalar members in
+        // place, until a member opens a container
+        while (token.has_value() && !_frames.empty()) {
+            const Frame &frame = _frames.back();
+            if (token->type() == closer(frame.kind)) {
+                if (!collapse(frame)) {
+                    return nullptr;
+                }
+
+                _frames.pop_back();
+                first = false;
+                token = next();
+                continue;
+            }
+
+            if (!first) {
+                if (token->type() != Type::COMMA) {
+                    Error &error = fail(Reason::EXPECTED_SEPARATOR);
+                    error.expected = frame.kind;
+                    error.setText(token->data());
+                    return nullptr;
+                }
+
+                token = next();
+                if (!token.has_value()) {
+                    return nullptr;
+                }
+            }
+            first = false;
+
+            if (frame.kind == Kind::OBJECT) {
+                if (token->type() != Type::STRING) {
+                    fail(Reason::EXPECTED_KEY).setText(token->data());
+                    return nullptr;
+                }
+                if (!parseValue(token.value())) {
+                    return nullptr;
+                }
+
+                token = next();
+                if (!token.has_value()) {
+                    return nullptr;
+                }
+                if (token->type() != Type::COLON) {
+                    fail(Reason::EXPECTED_COLON).setText(token->data());
+                    return nullptr;
+                }
+
+                token = next();
+                if (!token.has_value()) {
+                    return nullptr;
+                }
+            }
+
+            if (opens(token->type())) {
+                break;
+            }
+            if (!parseValue(token.value())) {
+                return nullptr;
+            }
+
+            token = next();
+        }
+
+        if (!token.has_value()) {
+            return nullptr;
+        }
+
+        if (_frames.empty()) {
+            if (token->type() != Type::END_OF_FILE) {
+                fail(Reason::TRAILING_DATA).setText(token->data());
+                return nullptr;
+            }
+
+            _root = _starts.back();
+            return _arena.make<Value>(_stack.back());
+        }
+    }
+
+    return nullptr;
+}
+
+const Blueprint::JSON::Value *Blueprint::JSON::Document::unpack(
+    std::string_view packed)
+{
+    _arena.reset();
+    _stack.clear();
+    _starts.clear();
+    _frames.clear();
+    _error.clear();
+    _offset = 0;
+    _packed = packed;
+    _position = 0;
+
+    if (!unpackValue()) {
+        return nullptr;
+    }
+
+    while (!_frames.empty()) {
+        Frame &frame = _frames.back();
+        if (frame.remaining == 0) {
+            if (!collapse(frame)) {
+                return nullptr;
+            }
+
+            _frames.pop_back();
+            continue;
+        }
+
+        // Members of a map alternate keys and values
+        bool key = frame.kind == Kind::OBJECT && frame.remaining % 2 == 0;
+        --frame.remaining;
+        if (!(key ? unpackKey() : unpackValue())) {
+            return nullptr;
+        }
+    }
+
+    if (_position != _packed.size()) {
+        _offset = _position;
+        marker(fail(Reason::TRAILING_DATA), _packed[_position]);
+        return nullptr;
+    }
+
+    _root = _starts.back();
+    return _arena.make<Value>(_stack.back());
+}
+
+void Blueprint::JSON::Document::clear()
+{
+    _arena.reset();
+    _stack.clear();
+    _starts.clear();
+    _frames.clear();
+}
+
+std::optional<Blueprint::JSON::Token> Blueprint::JSON::Document::next()
+{
+    std::optional<Token> token = _lexer.nextToken();
+    if (!token.has_value()) {
+        _error = _lexer.getError();
+        _offset = _error.offset;
+        return token;
+    }
+
+    _offset = token->offset();
+    if constexpr (STATS) {
+        if (_stats != nullptr) {
+            ++_stats->tokens;
+        }
+    }
+
+    return token;
+}
+
+bool Blueprint::JSON::Document::parseValue(const Token &token)
+{
+    std::string_view data = token.data();
+
+    if constexpr (STATS) {
+        if (_stats != nullptr) {
+            ++_stats->nodes;
+        }
+    }
+
+    switch (token.type()) {
+        case Type::STRING:
+            if (data.size() > std::numeric_limits<std::uint32_t>::max()) {
+                Error &error = fail(Reason::TOO_LARGE);
+                error.expected = Kind::STRING;
+                error.length = data.size();
+                return false;
+            }
+            push(Value::fromString(data));
+            return true;
+        case Type::NUMBER: {
+            const Number &number = token.number();
+            push(number.integral() ? Value::fromInteger(number.integer())
+                                   : Value::fromNumber(number.real()));
+            return true;
+        }
+        case Type::BOOLEAN:
+            push(Value::fromBoolean(data == "true"));
+            return true;
+        case Type::NULL_VALUE: push(Value::fromNull()); return true;
+        case Type::END_OF_FILE: fail(Reason::UNEXPECTED_END); break;
+        default: fail(Reason::UNEXPECTED_TOKEN).setText(data); break;
+    }
+
+    return false;
+}
+
+std::optional<std::string_view> Blueprint::JSON::Document::take(
+    std::size_t size)
+{
+    if (size > _packed.size() - _position) {
+        _offset = _packed.size();
+        fail(Reason::UNEXPECTED_END);
+        return std::nullopt;
+    }
+
+    std::string_view bytes = _packed.substr(_position, size);
+    _position += size;
+
+    return bytes;
+}
+
+std::optional<std::uint64_t> Blueprint::JSON::Document::length(
+    std::size_t size)
+{
+    std::optional<std::string_view> bytes = take(size);
+    if (!bytes.has_value()) {
+        return std::nullopt;
+    }
+
+    return big(bytes.value());
+}
+
+bool Blueprint::JSON::Document::unpackValue()
+{
+    _offset = _position;
+    std::optional<std::string_view> head = take(1);
+    if (!head.has_value()) {
+        return false;
+    }
+
+    if constexpr (STATS) {
+        if (_stats != nullptr) {
+            ++_stats->nodes;
+        }
+    }
+
+    auto tag = static_cast<std::uint8_t>(head->front());
+    if (tag <= 0x7f || tag >= 0xe0) {
+        push(Value::fromInteger(static_cast<std::int8_t>(tag)));
+        return true;
+    }
+
+    switch (tag & 0xf0) {
+        case 0x80: return open(Kind::OBJECT, (tag & 0x0f) * 2);
+        case 0x90: return open(Kind::ARRAY, tag & 0x0f);
+        case 0xa0:
+        case 0xb0: return unpackString(tag & 0x1f);
+        default: break;
+    }
+
+    std::optional<std::uint64_t> value;
+    switch (tag) {
+        case 0xc0: push(Value::fromNull()); return true;
+        case 0xc2: push(Value::fromBoolean(false)); return true;
+        case 0xc3: push(Value::fromBoolean(true)); return true;
+        case 0xca:
+        case 0xcb: {
+            value = length(tag == 0xca ? 4 : 8);
+            if (!value.has_value()) {
+                return false;
+            }
+
+            double real;
+            if (tag == 0xca) {
+                float single;
+                auto bits = static_cast<std::uint32_t>(value.value());
+                std::memcpy(&single, &bits, sizeof(single));
+                real = single;
+            } else {
+                std::memcpy(&real, &value.value(), sizeof(real));
+            }
+
+            // JSON has no literal for them, so no schema bound either
+            if (!std::isfinite(real)) {
+                fail(Reason::INVALID_NUMBER)
+                    .setText(std::isnan(real) ? "NaN" : "Infinity");
+                return false;
+            }
+
+            push(Value::fromNumber(real));
+            return true;
+        }
+        case 0xcc:
+        case 0xcd:
+        case 0xce:
+        case 0xcf:
+            value = length(std::size_t{1} << (tag - 0xcc));
+            if (!value.has_value()) {
+                return false;
+            }
+
+            // Past int64 a JSON number is read as a real as well
+            push(value.value() > std::numeric_limits<std::int64_t>::max()
+                    ? Value::fromNumber(static_cast<double>(value.value()))
+                    : Value::fromInteger(
+                          static_cast<std::int64_t>(value.value())));
+            return true;
+        case 0xd0:
+        case 0xd1:
+        case 0xd2:
+        case 0xd3: {
+            std::size_t size = std::size_t{1} << (tag - 0xd0);
+            value = length(size);
+            if (!value.has_value()) {
+                return false;
+            }
+
+            // Sign-extends the big-endian operand
+            unsigned shift = 64 - 8 * static_cast<unsigned>(size);
+            push(Value::fromInteger(
+                static_cast<std::int64_t>(value.value() << shift) >> shift));
+            return true;
+        }
+        case 0xd9:
+        case 0xda:
+        case 0xdb:
+            value = length(std::size_t{1} << (tag - 0xd9));
+            return value.has_value()
+                && unpackString(static_cast<std::size_t>(value.value()));
+        case 0xdc:
+        case 0xdd:
+            value = length(tag == 0xdc ? 2 : 4);
+            return value.has_value() && open(Kind::ARRAY, value.value());
+        case 0xde:
+        case 0xdf:
+            value = length(tag == 0xde ? 2 : 4);
+            return value.has_value()
+                && open(Kind::OBJECT, value.value() * 2);
+        default: break;
+    }
+
+    // Binary, extension and reserved types have no JSON counterpart
+    marker(fail(Reason::UNEXPECTED_TOKEN), head->front());
+
+    return false;
+}
+
+bool Blueprint::JSON::Document::unpackKey()
+{
+    if (_position < _packed.size()
+        && !key(static_cast<std::uint8_t>(_packed[_position]))) {
+        _offset = _position;
+        marker(fail(Reason::EXPECTED_KEY), _packed[_position]);
+        return false;
+    }
+
+    return unpackValue();
+}
+
+bool Blueprint::JSON::Document::unpackString(std::size_t size)
+{
+    std::optional<std::string_view> text = take(size);
+    if (!text.has_value()) {
+        return false;
+    }
+
+    // Strings are compared in their JSON form, only the few holding quotes,
+    // backslashes or control characters need a copy
+    std::size_t length = 0;
+    for (char ch : text.value()) {
+        length += escaped(ch);
+    }
+
+    if (length == text->size()) {
+        push(Value::fromString(text.value()));
+        return true;
+    }
+
+    static constexpr char DIGITS[] = "0123456789abcdef";
+    char *out = static_cast<char *>(_arena.allocate(length, 1));
+    std::size_t position = 0;
+    for (char ch : text.value()) {
+        std::size_t width = escaped(ch);
+        if (width == 1) {
+            out[position++] = ch;
+            continue;
+        }
+
+        out[position++] = '\\';
+        switch (ch) {
+            case '\b': out[position++] = 'b'; break;
+            case '\f': out[position++] = 'f'; break;
+            case '\n': out[position++] = 'n'; break;
+            case '\r': out[position++] = 'r'; break;
+            case '\t': out[position++] = 't'; break;
+            case '"':
+            case '\\': out[position++] = ch; break;
+            default: {
+                auto value = static_cast<std::uint8_t>(ch);
+                const char code[] = {
+                    'u', '0', '0', DIGITS[value >> 4], DIGITS[value & 0x0f]};
+                std::memcpy(out + position, code, sizeof(code));
+                position += sizeof(code);
+                break;
+            }
+        }
+    }
+
+    push(Value::fromString(std::string_view(out, length)));
+
+    return true;
+}
+
+bool Blueprint::JSON::Document::open(Kind kind, std::uint64_t remaining)
+{
+    if (_limit != 0 && _frames.size() == _limit) {
+        fail(Reason::TOO_DEEP).limit = _limit;
+        return false;
+    }
+
+    _frames.push_back({.start = _stack.size(),
+        .offset = _offset,
+        .remaining = remaining,
+        .kind = kind});
+    if constexpr (STATS) {
+        if (_stats != nullptr && _frames.size() > _stats->depth) {
+            _stats->depth = _frames.size();
+        }
+    }
+
+    return true;
+}
+
+void Blueprint::JSON::Document::push(Value value)
+{
+    _stack.push_back(value);
+    _starts.push_back(_offset);
+}
+
+bool Blueprint::JSON::Document::collapse(const Frame &frame)
+{
+    std::size_t start = frame.start;
+    Kind kind = frame.kind;
+    std::size_t count = _stack.size() - start;
+    std::size_t size = kind == Kind::OBJECT ? count / 2 : count;
+    if (size > std::numeric_limits<std::uint32_t>::max()) {
+        Error &error = fail(Reason::TOO_LARGE);
+        error.expected = kind;
+        error.length = size;
+        return false;
+    }
+
+    // The offsets of the children follow them in the same block
+    Value *children = nullptr;
+    if (count > 0) {
+        static_assert(sizeof(Value) % alignof(std::size_t) == 0,
+            "Offsets must follow the children unpadded");
+        children = static_cast<Value *>(_arena.allocate(
+            count * (sizeof(Value) + sizeof(std::size_t)), alignof(Value)));
+        std::uninitialized_copy_n(_stack.begin() + start, count, children);
+        std::uninitialized_copy_n(_starts.begin() + start, count,
+            reinterpret_cast<std::size_t *>(children + count));
+        _stack.resize(start);
+        _starts.resize(start);
+    }
+
+    _offset = frame.offset;
+    push(kind == Kind::OBJECT
+            ? Value::fromObject(children, static_cast<std::uint32_t>(size))
+            : Value::fromArray(children, static_cast<std::uint32_t>(size)));
+
+    return true;
+}
+
+std::size_t Blueprint::JSON::Document::offset() const
+{
+    return _root;
+}
+
+std::size_t Blueprint::JSON::Document::offset(
+    const Value &container, std::size_t index)
+{
+    std::size_t count = container.kind() == Kind::OBJECT
+        ? container.size() * 2
+        : container.size();
+
+    return reinterpret_cast<const std::size_t *>(
+        container.children() + count)[index];
+}
+
+void Blueprint::JSON::Document::setDepth(std::size_t depth)
+{
+    _limit = depth;
+}
+
+void Blueprint::JSON::Document::setStats(Stats *stats)
+{
+    _stats = stats;
+    _lexer.setStats(stats);
+}
+
+const Blueprint::JSON::Arena &Blueprint::JSON::Document::arena() const
+{
+    return _arena;
+}
+
+Blueprint::Error &Blueprint::JSON::Document::fail(Reason reason)
+{
+    _error.clear();
+    _error.reason = reason;
+    _error.offset = _offset;
+
+    return _error;
+}
+
+const Blueprint::Error &Blueprint::JSON::Document::getError() const
+{
+    return _error;
+}
@@ -0,0 +1,307 @@
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+#include "JSON/Index.hpp"
+
+#if defined(__x86_64__) || defined(_M_X64)
+    #define BLUEPRINT_X86
+    #include <immintrin.h>
+    #if defined(_MSC_VER) && !defined(__clang__)
+        #include <intrin.h>
+    #endif
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+    #define BLUEPRINT_AVX2 __attribute__((target("avx2")))
+#else
+    #define BLUEPRINT_AVX2
+#endif
+
+using Classifier = Blueprint::JSON::Masks (*)(const char *block);
+
+static constexpr std::size_t BLOCK = Blueprint::JSON::Index::BLOCK;
+static constexpr std::size_t WINDOW = Blueprint::JSON::Index::WINDOW;
+
+#ifndef BLUEPRINT_X86
+static Blueprint::JSON::Masks classifyScalar(const char *block)
+{
+    Blueprint::JSON::Masks masks = {0, 0, 0, 0};
+
+    for (std::size_t i = 0; i < BLOCK; ++i) {
+        std::uint64_t bit = std::uint64_t(1) << i;
+
+        switch (block[i]) {
+            case '{':
+            case '}':
+            case '[':
+            case ']':
+            case ':':
+            case ',': masks.structural |= bit; break;
+            case ' ':
+            case '\t':
+            case '\n':
+            case '\r': masks.whitespace |= bit; break;
+            case '"': masks.quote |= bit; break;
+            case '\\': masks.backslash |= bit; break;
+            default: break;
+        }
+    }
+
+    return masks;
+}
+#else
+static std::uint64_t mask128(__m128i bytes, std::size_t shift)
+{
+    auto bits = static_cast<std::uint32_t>(_mm_movemask_epi8(bytes));
+    return static_cast<std::uint64_t>(bits & 0xFFFF) << shift;
+}
+
+static __m128i equals128(__m128i bytes, char ch)
+{
+    return _mm_cmpeq_epi8(bytes, _mm_set1_epi8(ch));
+}
+
+static Blueprint::JSON::Masks classifySse2(const char *block)
+{
+    Blueprint::JSON::Masks masks = {0, 0, 0, 0};
+
+    for (std::size_t i = 0; i < BLOCK; i += 16) {
+        __m128i bytes =
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(block + i));
+
+        __m128i structural = _mm_or_si128(
+            _mm_or_si128(_mm_or_si128(equals128(bytes, '{'),
+                             equals128(bytes, '}')),
+                _mm_or_si128(equals128(bytes, '['), equals128(bytes, ']'))),
+            _mm_or_si128(equals128(bytes, ':'), equals128(bytes, ',')));
+        __m128i whitespace =
+            _mm_or_si128(_mm_or_si128(equals128(bytes, ' '),
+                             equals128(bytes, '\t')),
+                _mm_or_si128(equals128(bytes, '\n'), equals128(bytes, '\r')));
+
+        masks.structural |= mask128(structural, i);
+        masks.whitespace |= mask128(whitespace, i);
+        masks.quote |= mask128(equals128(bytes, '"'), i);
+        masks.backslash |= mask128(equals128(bytes, '\\'), i);
+    }
+
+    return masks;
+}
+
+BLUEPRINT_AVX2 static std::uint64_t mask256(__m256i bytes, std::size_t shift)
+{
+    auto bits = static_cast<std::uint32_t>(_mm256_movemask_epi8(bytes));
+    return static_cast<std::uint64_t>(bits) << shift;
+}
+
+BLUEPRINT_AVX2 static __m256i equals256(__m256i bytes, char ch)
+{
+    return _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8(ch));
+}
+
+BLUEPRINT_AVX2 static Blueprint::JSON::Masks classifyAvx2(const char *block)
+{
+    Blueprint::JSON::Masks masks = {0, 0, 0, 0};
+
+    for (std::size_t i = 0; i < BLOCK; i += 32) {
+        __m256i bytes =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i *>(block + i));
+
+        __m256i structural = _mm256_or_si256(
+            _mm256_or_si256(_mm256_or_si256(equals256(bytes, '{'),
+                                equals256(bytes, '}')),
+                _mm256_or_si256(
+                    equals256(bytes, '['), equals256(bytes, ']'))),
+            _mm256_or_si256(equals256(bytes, ':'), equals256(bytes, ',')));
+        __m256i whitespace = _mm256_or_si256(
+            _mm256_or_si256(equals256(bytes, ' '), equals256(bytes, '\t')),
+            _mm256_or_si256(equals256(bytes, '\n'), equals256(bytes, '\r')));
+
+        masks.structural |= mask256(structural, i);
+        masks.whitespace |= mask256(whitespace, i);
+        masks.quote |= mask256(equals256(bytes, '"'), i);
+        masks.backslash |= mask256(equals256(bytes, '\\'), i);
+    }
+
+    return masks;
+}
+
+static bool supportsAvx2()
+{
+    #if defined(__GNUC__) || defined(__clang__)
+    return __builtin_cpu_supports("avx2");
+    #else
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) {
+        return false;
+    }
+
+    __cpuid(info, 1);
+    bool osxsave = (info[2] & (1 << 27)) != 0;
+    bool avx = (info[2] & (1 << 28)) != 0;
+    if (!osxsave || !avx || (_xgetbv(0) & 6) != 6) {
+        return false;
+    }
+
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+    #endif
+}
+#endif
+
+struct Backend {
+    Classifier classify;
+    const char *name;
+};
+
+static const Backend &select()
+{
+    static const Backend backend = []() -> Backend {
+#ifdef BLUEPRINT_X86
+        if (supportsAvx2()) {
+            return {classifyAvx2, "avx2"};
+        }
+
+        return {classifySse2, "sse2"};
+#else
+        return {classifyScalar, "scalar"};
+#endif
+    }();
+
+    return backend;
+}
+
+// Marks every byte preceded by an odd run of backslashes. The carry is set
+// when the block ends with such a backslash, escaping the next block's first
+// byte.
+static std::uint64_t escapes(std::uint64_t backslash, std::uint64_t &carry)
+{
+    std::uint64_t escaped = carry;
+    std::uint64_t pending = backslash & ~carry;
+    carry = 0;
+
+    while (pending != 0) {
+        int bit = std::countr_zero(pending);
+        pending &= pending - 1;
+
+        if (bit == 63) {
+            carry = 1;
+            break;
+        }
+
+        std::uint64_t next = std::uint64_t(1) << (bit + 1);
+        escaped |= next;
+        pending &= ~next;
+    }
+
+    return escaped;
+}
+
+// Sets every bit from an opening quote up to, but excluding, its closing one
+static std::uint64_t prefixXor(std::uint64_t bits)
+{
+    bits ^= bits << 1;
+    bits ^= bits << 2;
+    bits ^= bits << 4;
+    bits ^= bits << 8;
+    bits ^= bits << 16;
+    bits ^= bits << 32;
+
+    return bits;
+}
+
+void Blueprint::JSON::Index::classify(const char *block, std::size_t offset)
+{
+    Masks masks = select().classify(block);
+
+    std::uint64_t escaped = 0;
+    if (masks.backslash != 0 || _escaped != 0) {
+        escaped = escapes(masks.backslash, _escaped);
+    }
+
+    std::uint64_t quote = masks.quote & ~escaped;
+    std::uint64_t string = prefixXor(quote) ^ _string;
+    _string = string >> 63 ? ~std::uint64_t(0) : 0;
+
+    std::uint64_t outside = ~(string | quote);
+    std::uint64_t scalar = outside & ~(masks.structural | masks.whitespace);
+    std::uint64_t follows = (scalar << 1) | _scalar;
+    _scalar = scalar >> 63;
+
+    std::uint64_t positions =
+        (masks.structural & outside) | (scalar & ~follows) | quote;
+
+    // Positions are written four at a time into the slack at the end of the
+    // buffer, only the first popcount of them are kept
+    std::size_t *out = _positions.data() + _size;
+    _size += std::popcount(positions);
+
+    while (positions != 0) {
+        for (std::size_t i = 0; i < 4; ++i) {
+            out[i] = offset + std::countr_zero(positions);
+            positions &= positions - 1;
+        }
+
+        out += 4;
+    }
+}
+
+void Blueprint::JSON::Index::refill()
+{
+    if (_positions.empty()) {
+        _positions.resize(WINDOW + 4);
+    }
+
+    _size = 0;
+    _cursor = 0;
+
+    std::uint64_t start = 0;
+    if constexpr (STATS) {
+        start = Stats::now();
+    }
+
+    std::size_t end = std::min(_json.size(), _offset + WINDOW);
+    while (_offset < end) {
+        std::size_t remaining = _json.size() - _offset;
+
+        if (remaining >= BLOCK) {
+            classify(_json.data() + _offset, _offset);
+        } else {
+            char block[BLOCK];
+            std::memset(block, ' ', BLOCK);
+            std::memcpy(block, _json.data() + _offset, remaining);
+            classify(block, _offset);
+        }
+
+        _offset += BLOCK;
+    }
+
+    if constexpr (STATS) {
+        if (_stats != nullptr) {
+            _stats->lex += Stats::now() - start;
+        }
+    }
+}
+
+void Blueprint::JSON::Index::reset(std::string_view json)
+{
+    _json = json;
+    _size = 0;
+    _cursor = 0;
+    _offset = 0;
+    _string = 0;
+    _escaped = 0;
+    _scalar = 0;
+}
+
+void Blueprint::JSON::Index::setStats(Stats *stats)
+{
+    _stats = stats;
+}
+
+const char *Blueprint::JSON::Index::backend()
+{
+    return select().name;
+}
@@ -1,153 +1,220 @@
 #include <optional>
 
+#include "Error.hpp"
+#include "JSON/Kind.hpp"
 #include "JSON/Lexer.hpp"
 #include "JSON/Token.hpp"
 
-void Blueprint::JSON::Lexer::skipWhitespace()
+// Literals must be followed by whitespace, a structural character or the end
+bool Blueprint::JSON::Lexer::delimited()
 {
-    while (_position < _json.length() && isspace(_json[_position])) {
-        ++_position;
+    if (_position >= _json.length()) {
+        return true;
+    }
+
+    switch (_json[_position]) {
+        case ' ':
+        case '\t':
+        case '\n':
+        case '\r':
+        case '{':
+        case '}':
+        case '[':
+        case ']':
+        case ':':
+        case ',':
+        case '"': return true;
+        default: break;
     }
+
+    fail(Reason::UNEXPECTED_CHAR, _position)
+        .setText(_json.substr(_position, 1));
+
+    return false;
 }
 
 std::optional<Blueprint::JSON::Token> Blueprint::JSON::Lexer::advanceAndReturn(
-    Type type, const std::string &value)
+    Type type)
 {
-    ++_position;
-    return Token(type, value);
+    std::size_t start = _position++;
+    return Token(type, start, _json.substr(start, 1));
 }
 
 std::optional<Blueprint::JSON::Token> Blueprint::JSON::Lexer::parseString()
 {
     std::size_t start = ++_position;
+    _position = _index.next();
 
-    while (_position < _json.length() && _json[_position] != '"') {
-        ++_position;
-    }
-
-    if (_position > _json.length()) {
-        setError("Expected '\"' at JSON::{}", _position);
+    if (_position >= _json.length()) {
+        fail(Reason::UNTERMINATED_STRING, _json.length());
         return std::nullopt;
     }
 
-    std::string str = _json.substr(start, _position - start);
+    std::string_view str = _json.substr(start, _position - start);
     ++_position;
 
-    return Token(Type::STRING, str);
+    return Token(Type::STRING, start - 1, str);
 }
 
 std::optional<Blueprint::JSON::Token> Blueprint::JSON::Lexer::parseNumber()
 {
-    size_t start = _position;
-
-    if (_json[_position] == '-') {
-        ++_position;
-    }
+    std::size_t start = _position;
 
-    while (_position < _json.length() && isdigit(_json[_position])) {
+    while (_position < _json.length()) {
+        char ch = _json[_position];
+        if ((ch < '0' || ch > '9') && ch != '-' && ch != '+' && ch != '.'
+            && ch != 'e' && ch != 'E') {
+            break;
+        }
         ++_position;
     }
 
-    if (_position < _json.length() && _json[_position] == '.') {
-        ++_position;
-        while (_position < _json.length() && isdigit(_json[_position])) {
-            ++_position;
-        }
+    if (!delimited()) {
+        return std::nullopt;
     }
 
-    if (_position < _json.length()
-        && (_json[_position] == 'e' || _json[_position] == 'E')) {
-        ++_position;
-        if (_position < _json.length()
-            && (_json[_position] == '+' || _json[_position] == '-')) {
-            ++_position;
-        }
-        while (_position < _json.length() && isdigit(_json[_position])) {
-            ++_position;
-        }
+    std::string_view literal = _json.substr(start, _position - start);
+    std::optional<Number> number = Number::parse(literal);
+    if (!number.has_value()) {
+        fail(Reason::INVALID_NUMBER, start).setText(literal);
+        return std::nullopt;
     }
 
-    std::string number = _json.substr(start, _position - start);
-    return Token(Type::NUMBER, number);
+    return Token(start, literal, number.value());
 }
 
 std::optional<Blueprint::JSON::Token> Blueprint::JSON::Lexer::parseNull()
 {
+    std::size_t start = _position;
+
     if (_json.substr(_position, 4) == "null") {
         _position += 4;
-        return Token(Type::NULL_VALUE, "null");
+        if (!delimited()) {
+            return std::nullopt;
+        }
+
+        return Token(Type::NULL_VALUE, start, _json.substr(start, 4));
     }
 
-    setError("Expected 'null' at JSON::{}, got '{}'", _position, getWord());
+    Error &error = fail(Reason::INVALID_LITERAL, _position);
+    error.expected = Kind::NULL_VALUE;
+    error.setText(getWord());
 
     return std::nullopt;
 }
 
 std::optional<Blueprint::JSON::Token> Blueprint::JSON::Lexer::parseBoolean()
 {
+    std::size_t start = _position;
+
     if (_json[_position] == 'f' && _json.substr(_position, 5) == "false") {
         _position += 5;
-        return Token(Type::BOOLEAN, "false");
+        if (!delimited()) {
+            return std::nullopt;
+        }
+
+        return Token(Type::BOOLEAN, start, _json.substr(start, 5));
     }
 
     if (_json[_position] == 't' && _json.substr(_position, 4) == "true") {
         _position += 4;
-        return Token(Type::BOOLEAN, "true");
+        if (!delimited()) {
+            return std::nullopt;
+        }
+
+        return Token(Type::BOOLEAN, start, _json.substr(start, 4));
     }
 
-    setError("Expected 'true' or 'false' at JSON::{}, got '{}'", _position,
-        getWord());
+    Error &error = fail(Reason::INVALID_LITERAL, _position);
+    error.expected = Kind::BOOLEAN;
+    error.setText(getWord());
 
     return std::nullopt;
 }
 
-Blueprint::JSON::Lexer::Lexer(const std::string &json) : _json(json)
+Blueprint::JSON::Lexer::Lexer(std::string_view json)
+{
+    reset(json);
+}
+
+void Blueprint::JSON::Lexer::reset(std::string_view json)
+{
+    _json = json;
+    _error.clear();
+    _position = 0;
+    _start = 0;
+    _index.reset(json);
+}
+
+void Blueprint::JSON::Lexer::setStats(Stats *stats)
 {
+    _index.setStats(stats);
 }
 
 std::optional<Blueprint::JSON::Token> Blueprint::JSON::Lexer::nextToken()
 {
-    skipWhitespace();
+    _position = _index.next();
+    _start = _position;
 
     if (_position >= _json.length()) {
-        return Token(Type::END_OF_FILE, "");
+        return Token(Type::END_OF_FILE, _position, {});
     }
 
     char ch = _json[_position];
 
     switch (ch) {
-        case '{': return advanceAndReturn(Type::OBJECT_START, "{");
-        case '}': return advanceAndReturn(Type::OBJECT_END, "}");
-        case '[': return advanceAndReturn(Type::ARRAY_START, "[");
-        case ']': return advanceAndReturn(Type::ARRAY_END, "]");
-        case ':': return advanceAndReturn(Type::COLON, ":");
-        case ',': return advanceAndReturn(Type::COMMA, ",");
+        case '{': return advanceAndReturn(Type::OBJECT_START);
+        case '}': return advanceAndReturn(Type::OBJECT_END);
+        case '[': return advanceAndReturn(Type::ARRAY_START);
+        case ']': return advanceAndReturn(Type::ARRAY_END);
+        case ':': return advanceAndReturn(Type::COLON);
+        case ',': return advanceAndReturn(Type::COMMA);
         case '"': return parseString();
         case 't':
         case 'f': return parseBoolean();
         case 'n': return parseNull();
         default:
-            if (isdigit(ch) || ch == '-') {
+            if ((ch >= '0' && ch <= '9') || ch == '-') {
                 return parseNumber();
             }
     }
 
-    setError("Unexpected char '{}' at JSON::{}", ch, _position);
+    fail(Reason::UNEXPECTED_CHAR, _position)
+        .setText(_json.substr(_position, 1));
 
     return std::nullopt;
 }
 
-const std::string Blueprint::JSON::Lexer::getWord() const
+std::string_view Blueprint::JSON::Lexer::getWord() const
 {
     std::size_t position = _json.find(' ', _position);
-    std::string word = position == std::string::npos
+
+    return position == std::string_view::npos
         ? _json.substr(_position)
         : _json.substr(_position, position - _position);
+}
+
+std::size_t Blueprint::JSON::Lexer::position() const
+{
+    return _position;
+}
 
-    return word;
+std::size_t Blueprint::JSON::Lexer::start() const
+{
+    return _start;
+}
+
+Blueprint::Error &Blueprint::JSON::Lexer::fail(
+    Reason reason, std::size_t offset)
+{
+    _error.clear();
+    _error.reason = reason;
+    _error.offset = offset;
+
+    return _error;
 }
 
-const std::string &Blueprint::JSON::Lexer::getError() const
+const Blueprint::Error &Blueprint::JSON::Lexer::getError() const
 {
     return _error;
 }
@@ -0,0 +1,212 @@
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+
+#include "JSON/Number.hpp"
+
+// Exponents are saturated here, far beyond the range of a double
+static constexpr std::int64_t MAX = 1 << 20;
+
+static bool isDigit(char ch)
+{
+    return ch >= '0' && ch <= '9';
+}
+
+static const char *skipDigits(const char *it, const char *end)
+{
+    while (it != end && isDigit(*it)) {
+        ++it;
+    }
+
+    return it;
+}
+
+// Orders an integer against a double without rounding either of them
+static std::partial_ordering compare(std::int64_t integer, double real)
+{
+    if (std::isnan(real)) {
+        return std::partial_ordering::unordered;
+    }
+
+    if (real >= 0x1p63) {
+        return std::partial_ordering::less;
+    }
+
+    if (real < -0x1p63) {
+        return std::partial_ordering::greater;
+    }
+
+    auto whole = static_cast<std::int64_t>(real);
+    if (integer != whole) {
+        return integer <=> whole;
+    }
+
+    return 0.0 <=> real - static_cast<double>(whole);
+}
+
+Blueprint::JSON::Number::Number() : _integer(0)
+{
+}
+
+Blueprint::JSON::Number Blueprint::JSON::Number::fromInteger(
+    std::int64_t value)
+{
+    Number result;
+    result._integer = value;
+
+    return result;
+}
+
+Blueprint::JSON::Number Blueprint::JSON::Number::fromReal(double value)
+{
+    Number result;
+    result._integral = false;
+    result._real = value;
+
+    return result;
+}
+
+std::optional<Blueprint::JSON::Number> Blueprint::JSON::Number::parse(
+    std::string_view text)
+{
+    const char *it = text.data();
+    const char *end = it + text.size();
+
+    bool negative = it != end && *it == '-';
+    if (negative) {
+        ++it;
+    }
+
+    const char *digits = it;
+    if (it != end && *it == '0') {
+        ++it;
+    } else {
+        it = skipDigits(it, end);
+    }
+
+    if (it == digits) {
+        return std::nullopt;
+    }
+
+    std::size_t count = it - digits;
+    const char *fraction = end;
+    std::int64_t exponent = 0;
+
+    if (it != end && *it == '.') {
+        fraction = ++it;
+        it = skipDigits(it, end);
+        if (it == fraction) {
+            return std::nullopt;
+        }
+    }
+
+    bool integral = fraction == end;
+    if (it != end && (*it == 'e' || *it == 'E')) {
+        integral = false;
+        ++it;
+
+        bool below = it != end && *it == '-';
+        if (it != end && (*it == '+' || *it == '-')) {
+            ++it;
+        }
+
+        const char *start = it;
+        for (; it != end && isDigit(*it); ++it) {
+            exponent = std::min(exponent * 10 + (*it - '0'), MAX);
+        }
+
+        if (it == start) {
+            return std::nullopt;
+        }
+
+        exponent = below ? -exponent : exponent;
+    }
+
+    if (it != end) {
+        return std::nullopt;
+    }
+
+    // Up to 18 digits always fit an int64 and are accumulated directly
+    if (integral && count <= 18) {
+        std::int64_t value = 0;
+        for (const char *digit = digits; digit != digits + count; ++digit) {
+            value = value * 10 + (*digit - '0');
+        }
+
+        return fromInteger(negative ? -value : value);
+    }
+
+    if (integral) {
+        std::int64_t value = 0;
+        auto [last, error] = std::from_chars(text.data(), end, value);
+        if (error == std::errc() && last == end) {
+            return fromInteger(value);
+        }
+    }
+
+    double value = 0;
+    auto [last, error] = std::from_chars(text.data(), end, value);
+    if (error == std::errc() && last == end) {
+        return fromReal(value);
+    }
+
+    if (error != std::errc::result_out_of_range) {
+        return std::nullopt;
+    }
+
+    // Out of range either way: decide by the decimal magnitude whether the
+    // literal overflows, which is rejected, or underflows to zero
+    std::int64_t magnitude = static_cast<std::int64_t>(count);
+    if (count == 1 && *digits == '0' && fraction != end) {
+        const char *first = fraction;
+        while (first != end && *first == '0') {
+            ++first;
+        }
+
+        magnitude = fraction - first;
+    }
+
+    if (magnitude + exponent > 0) {
+        return std::nullopt;
+    }
+
+    return fromReal(negative ? -0.0 : 0.0);
+}
+
+bool Blueprint::JSON::Number::integral() const
+{
+    return _integral;
+}
+
+std::int64_t Blueprint::JSON::Number::integer() const
+{
+    return _integral ? _integer : static_cast<std::int64_t>(_real);
+}
+
+double Blueprint::JSON::Number::real() const
+{
+    return _integral ? static_cast<double>(_integer) : _real;
+}
+
+std::partial_ordering Blueprint::JSON::Number::operator<=>(
+    const Number &other) const
+{
+    if (_integral && other._integral) {
+        return _integer <=> other._integer;
+    }
+
+    if (!_integral && !other._integral) {
+        return _real <=> other._real;
+    }
+
+    if (_integral) {
+        return compare(_integer, other._real);
+    }
+
+    return 0 <=> compare(other._integer, _real);
+}
+
+bool Blueprint::JSON::Number::operator==(const Number &other) const
+{
+    return (*this <=> other) == 0;
+}
@@ -1,7 +1,14 @@
 #include "JSON/Token.hpp"
 
-Blueprint::JSON::Token::Token(Type type, const std::string data)
-    : _type(type), _data(data)
+Blueprint::JSON::Token::Token(
+    Type type, std::size_t offset, std::string_view data)
+    : _type(type), _offset(offset), _data(data)
+{
+}
+
+Blueprint::JSON::Token::Token(
+    std::size_t offset, std::string_view data, Number number)
+    : _type(Type::NUMBER), _offset(offset), _data(data), _number(number)
 {
 }
 
@@ -10,7 +17,17 @@ Blueprint::JSON::Type Blueprint::JSON::Token::type() const
     return _type;
 }
 
-const std::string &Blueprint::JSON::Token::data() const
+std::size_t Blueprint::JSON::Token::offset() const
+{
+    return _offset;
+}
+
+std::string_view Blueprint::JSON::Token::data() const
 {
     return _data;
 }
+
+const Blueprint::JSON::Number &Blueprint::JSON::Token::number() const
+{
+    return _number;
+}
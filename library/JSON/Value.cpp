@@ -0,0 +1,130 @@
+#include "JSON/Value.hpp"
+
+Blueprint::JSON::Value::Value() : _integer(0)
+{
+}
+
+Blueprint::JSON::Value Blueprint::JSON::Value::fromNull()
+{
+    return Value();
+}
+
+Blueprint::JSON::Value Blueprint::JSON::Value::fromBoolean(bool value)
+{
+    Value result;
+    result._kind = Kind::BOOLEAN;
+    result._boolean = value;
+
+    return result;
+}
+
+Blueprint::JSON::Value Blueprint::JSON::Value::fromNumber(double value)
+{
+    Value result;
+    result._kind = Kind::NUMBER;
+    result._number = value;
+
+    return result;
+}
+
+Blueprint::JSON::Value Blueprint::JSON::Value::fromInteger(std::int64_t value)
+{
+    Value result;
+    result._kind = Kind::NUMBER;
+    result._integral = true;
+    result._integer = value;
+
+    return result;
+}
+
+Blueprint::JSON::Value Blueprint::JSON::Value::fromString(
+    std::string_view value)
+{
+    Value result;
+    result._kind = Kind::STRING;
+    result._string = value.data();
+    result._size = static_cast<std::uint32_t>(value.size());
+
+    return result;
+}
+
+Blueprint::JSON::Value Blueprint::JSON::Value::fromArray(
+    const Value *elements, std::uint32_t size)
+{
+    Value result;
+    result._kind = Kind::ARRAY;
+    result._children = elements;
+    result._size = size;
+
+    return result;
+}
+
+Blueprint::JSON::Value Blueprint::JSON::Value::fromObject(
+    const Value *members, std::uint32_t size)
+{
+    Value result;
+    result._kind = Kind::OBJECT;
+    result._children = members;
+    result._size = size;
+
+    return result;
+}
+
+Blueprint::JSON::Kind Blueprint::JSON::Value::kind() const
+{
+    return _kind;
+}
+
+bool Blueprint::JSON::Value::integral() const
+{
+    return _integral;
+}
+
+bool Blueprint::JSON::Value::boolean() const
+{
+    return _boolean;
+}
+
+double Blueprint::JSON::Value::number() const
+{
+    return _integral ? static_cast<double>(_integer) : _number;
+}
+
+std::int64_t Blueprint::JSON::Value::integer() const
+{
+    return _integral ? _integer : static_cast<std::int64_t>(_number);
+}
+
+Blueprint::JSON::Number Blueprint::JSON::Value::toNumber() const
+{
+    return _integral ? Number::fromInteger(_integer)
+                     : Number::fromReal(_number);
+}
+
+std::string_view Blueprint::JSON::Value::string() const
+{
+    return {_string, _size};
+}
+
+std::size_t Blueprint::JSON::Value::size() const
+{
+    return _size;
+}
+
+// Objects store their members as consecutive (key, value) pairs
+const Blueprint::JSON::Value *Blueprint::JSON::Value::children() const
+{
+    return _children;
+}
+
+const Blueprint::JSON::Value *Blueprint::JSON::Value::find(
+    std::string_view key) const
+{
+    for (std::size_t i = 0; i < _size; ++i) {
+        if (_children[i * 2].string() == key) {
+            return &_children[i * 2 + 1];
+        }
+    }
+
+    return nullptr;
+}
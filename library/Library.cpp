@@ -0,0 +1,111 @@
+#include <string>
+
+#ifdef _WIN32
+    #define WIN32_LEAN_AND_MEAN
+    #include <windows.h>
+#else
+    #include <dlfcn.h>
+#endif
+
+#include "Library.hpp"
+#include "Plugin.hpp"
+
+Blueprint::Library::~Library()
+{
+    close();
+}
+
+#ifdef _WIN32
+
+bool Blueprint::Library::open(const std::string &path)
+{
+    close();
+    _error.clear();
+
+    HMODULE module = LoadLibraryA(path.c_str());
+    if (module == nullptr) {
+        _error = "Failed to load '" + path + "'";
+        return false;
+    }
+
+    _handle = module;
+    auto entry = reinterpret_cast<Plugin::Entry>(
+        reinterpret_cast<void *>(GetProcAddress(module, Plugin::ENTRY)));
+    if (entry == nullptr) {
+        close();
+        _error = "'" + path + "' does not export " + Plugin::ENTRY;
+        return false;
+    }
+
+    _plugin = entry();
+    if (_plugin == nullptr || _plugin->version != Plugin::VERSION) {
+        close();
+        _error = "'" + path + "' was built for another plugin version";
+        return false;
+    }
+
+    return true;
+}
+
+void Blueprint::Library::close()
+{
+    if (_handle != nullptr) {
+        FreeLibrary(static_cast<HMODULE>(_handle));
+    }
+
+    _handle = nullptr;
+    _plugin = nullptr;
+}
+
+#else
+
+bool Blueprint::Library::open(const std::string &path)
+{
+    close();
+    _error.clear();
+
+    _handle = dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL);
+    if (_handle == nullptr) {
+        _error = "Failed to load '" + path + "': " + dlerror();
+        return false;
+    }
+
+    auto entry =
+        reinterpret_cast<Plugin::Entry>(dlsym(_handle, Plugin::ENTRY));
+    if (entry == nullptr) {
+        close();
+        _error = "'" + path + "' does not export " + Plugin::ENTRY;
+        return false;
+    }
+
+    _plugin = entry();
+    if (_plugin == nullptr || _plugin->version != Plugin::VERSION) {
+        close();
+        _error = "'" + path + "' was built for another plugin version";
+        return false;
+    }
+
+    return true;
+}
+
+void Blueprint::Library::close()
+{
+    if (_handle != nullptr) {
+        dlclose(_handle);
+    }
+
+    _handle = nullptr;
+    _plugin = nullptr;
+}
+
+#endif
+
+const Blueprint::Plugin *Blueprint::Library::plugin() const
+{
+    return _plugin;
+}
+
+const std::string &Blueprint::Library::getError() const
+{
+    return _error;
+}
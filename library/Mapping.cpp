@@ -0,0 +1,141 @@
+#include <string>
+#include <string_view>
+
+#ifdef _WIN32
+    #define WIN32_LEAN_AND_MEAN
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+#include "Mapping.hpp"
+
+Blueprint::Mapping::~Mapping()
+{
+    close();
+}
+
+#ifdef _WIN32
+
+bool Blueprint::Mapping::open(const std::string &path)
+{
+    close();
+    _error.clear();
+
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ,
+        nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        _error = "Failed to open '" + path + "'";
+        return false;
+    }
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size)) {
+        CloseHandle(file);
+        _error = "Failed to read the size of '" + path + "'";
+        return false;
+    }
+
+    if (size.QuadPart == 0) {
+        CloseHandle(file);
+        return true;
+    }
+
+    // The view outlives both handles, nothing is read until touched
+    HANDLE mapping =
+        CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (mapping == nullptr) {
+        _error = "Failed to map '" + path + "'";
+        return false;
+    }
+
+    void *data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+    if (data == nullptr) {
+        _error = "Failed to map '" + path + "'";
+        return false;
+    }
+
+    _data = static_cast<const char *>(data);
+    _size = static_cast<std::size_t>(size.QuadPart);
+
+    return true;
+}
+
+void Blueprint::Mapping::close()
+{
+    if (_data != nullptr) {
+        UnmapViewOfFile(_data);
+    }
+
+    _data = nullptr;
+    _size = 0;
+}
+
+#else
+
+bool Blueprint::Mapping::open(const std::string &path)
+{
+    close();
+    _error.clear();
+
+    int descriptor = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (descriptor < 0) {
+        _error = "Failed to open '" + path + "'";
+        return false;
+    }
+
+    struct stat status;
+    if (fstat(descriptor, &status) != 0 || !S_ISREG(status.st_mode)) {
+        ::close(descriptor);
+        _error = "'" + path + "' is not a regular file";
+        return false;
+    }
+
+    std::size_t size = static_cast<std::size_t>(status.st_size);
+    if (size == 0) {
+        ::close(descriptor);
+        return true;
+    }
+
+    // The mapping outlives the descriptor, nothing is read until touched
+    void *data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+    ::close(descriptor);
+    if (data == MAP_FAILED) {
+        _error = "Failed to map '" + path + "'";
+        return false;
+    }
+
+    madvise(data, size, MADV_SEQUENTIAL);
+
+    _data = static_cast<const char *>(data);
+    _size = size;
+
+    return true;
+}
+
+void Blueprint::Mapping::close()
+{
+    if (_data != nullptr) {
+        munmap(const_cast<char *>(_data), _size);
+    }
+
+    _data = nullptr;
+    _size = 0;
+}
+
+#endif
+
+std::string_view Blueprint::Mapping::view() const
+{
+    return {_data == nullptr ? "" : _data, _size};
+}
+
+const std::string &Blueprint::Mapping::getError() const
+{
+    return _error;
+}
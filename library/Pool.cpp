@@ -0,0 +1,153 @@
+#include <algorithm>
+#include <utility>
+
+#include "Pool.hpp"
+
+Blueprint::Pool::Pool(std::size_t size)
+{
+    size = std::max<std::size_t>(size, 1);
+
+    for (std::size_t i = 0; i < size; ++i) {
+        _queues.push_back(std::make_unique<Queue>());
+    }
+
+    for (std::size_t i = 1; i < size; ++i) {
+        _threads.emplace_back(&Pool::loop, this, i);
+    }
+}
+
+Blueprint::Pool::~Pool()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stop = true;
+    }
+
+    _wake.notify_all();
+    for (std::thread &thread : _threads) {
+        thread.join();
+    }
+}
+
+void Blueprint::Pool::loop(std::size_t worker)
+{
+    std::uint64_t seen = 0;
+
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _wake.wait(lock, [&] { return _stop || _generation != seen; });
+            if (_stop) {
+                return;
+            }
+
+            seen = _generation;
+        }
+
+        drain(worker);
+    }
+}
+
+void Blueprint::Pool::drain(std::size_t worker)
+{
+    while (std::optional<Range> range = take(worker)) {
+        // Exceptions must not leave a spawned thread, they are handed over
+        // to the thread calling run
+        if (!_failed.load(std::memory_order_relaxed)) {
+            try {
+                (*_task)(worker, range->begin, range->end);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(_mutex);
+                if (_failure == nullptr) {
+                    _failure = std::current_exception();
+                }
+                _failed.store(true, std::memory_order_relaxed);
+            }
+        }
+
+        if (_pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _done.notify_all();
+        }
+    }
+}
+
+std::optional<Blueprint::Pool::Range> Blueprint::Pool::take(
+    std::size_t worker)
+{
+    {
+        Queue &own = *_queues[worker];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.ranges.empty()) {
+            Range range = own.ranges.back();
+            own.ranges.pop_back();
+            return range;
+        }
+    }
+
+    for (std::size_t i = 1; i < _queues.size(); ++i) {
+        Queue &victim = *_queues[(worker + i) % _queues.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.ranges.empty()) {
+            Range range = victim.ranges.front();
+            victim.ranges.pop_front();
+            return range;
+        }
+    }
+
+    return std::nullopt;
+}
+
+void Blueprint::Pool::run(
+    std::size_t count, std::size_t grain, const Task &task)
+{
+    if (count == 0) {
+        return;
+    }
+
+    grain = std::max<std::size_t>(grain, 1);
+    std::size_t ranges = (count + grain - 1) / grain;
+
+    if (_threads.empty() || ranges == 1) {
+        for (std::size_t begin = 0; begin < count; begin += grain) {
+            task(0, begin, std::min(begin + grain, count));
+        }
+        return;
+    }
+
+    // The task is published before any range, a worker only reads it after
+    // popping one
+    _task = &task;
+    _pending.store(ranges, std::memory_order_release);
+
+    for (std::size_t i = 0; i < ranges; ++i) {
+        Queue &queue = *_queues[i % _queues.size()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.ranges.push_back(
+            {.begin = i * grain, .end = std::min((i + 1) * grain, count)});
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        ++_generation;
+    }
+
+    _wake.notify_all();
+    drain(0);
+
+    std::unique_lock<std::mutex> lock(_mutex);
+    _done.wait(lock, [&] {
+        return _pending.load(std::memory_order_acquire) == 0;
+    });
+
+    if (_failure != nullptr) {
+        std::exception_ptr failure = std::exchange(_failure, nullptr);
+        _failed.store(false, std::memory_order_relaxed);
+        std::rethrow_exception(failure);
+    }
+}
+
+std::size_t Blueprint::Pool::size() const
+{
+    return _queues.size();
+}
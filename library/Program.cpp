@@ -0,0 +1,689 @@
+#include <cmath>
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include "Error.hpp"
+#include "JSON/Document.hpp"
+#include "JSON/Value.hpp"
+#include "Library.hpp"
+#include "Plugin.hpp"
+#include "Program.hpp"
+
+// Constraint of every binary tag, in the order of the TS constraint flags
+static constexpr std::string_view CONSTRAINTS[] = {
+    "MIN_VALUE",
+    "MAX_VALUE",
+    "MIN_LENGTH",
+    "MAX_LENGTH",
+    "ENUM",
+    "REQUIRED",
+    "VALUES",
+    "ADDITIONAL_PROPERTIES",
+};
+
+bool Blueprint::Program::load(std::string_view schema, std::size_t depth)
+{
+    if (Reader::matches(schema)) {
+        Reader reader(schema);
+        reader.byte();
+        std::optional<std::uint8_t> version = reader.byte();
+        if (version != Reader::VERSION) {
+            setError("Unsupported binary schema version {}",
+                version.value_or(0));
+            return false;
+        }
+
+        _nodes.clear();
+        if (!decode(reader, depth)) {
+            return false;
+        }
+
+        if (!reader.done()) {
+            setError("Trailing bytes in binary schema at byte {}",
+                reader.position());
+            return false;
+        }
+
+        return true;
+    }
+
+    JSON::Document document;
+    const JSON::Value *root = document.parse(schema);
+    if (root == nullptr) {
+        Error error = document.getError();
+        error.locate(schema);
+        setError("Invalid schema: {}", error.format(nullptr));
+        return false;
+    }
+
+    _nodes.clear();
+
+    return lower(*root, depth);
+}
+
+std::optional<std::size_t> Blueprint::Program::shape(
+    const JSON::Value &schema, const JSON::Value *&data)
+{
+    if (schema.kind() != Kind::OBJECT) {
+        setError("Invalid schema. Expected object, got '{}'",
+            Program::name(schema.kind()));
+        return std::nullopt;
+    }
+
+    const JSON::Value *type = schema.find("type");
+    if (type == nullptr || type->kind() != Kind::STRING) {
+        setError("Missing schema type");
+        return std::nullopt;
+    }
+
+    std::optional<Kind> kind = Program::kind(type->string());
+    if (!kind.has_value()) {
+        setError("Unknown schema type '{}'", type->string());
+        return std::nullopt;
+    }
+
+    Node node;
+    node.kind = kind.value();
+
+    const JSON::Value *constraints = schema.find("constraints");
+    if (constraints != nullptr) {
+        if (constraints->kind() != Kind::ARRAY) {
+            setError("Invalid constraints for '{}'", type->string());
+            return std::nullopt;
+        }
+
+        for (std::size_t i = 0; i < constraints->size(); ++i) {
+            const JSON::Value &constraint = constraints->children()[i];
+            if (constraint.kind() != Kind::OBJECT) {
+                setError("Invalid constraint of type '{}'",
+                    Program::name(constraint.kind()));
+                return std::nullopt;
+            }
+
+            const JSON::Value *members = constraint.children();
+            for (std::size_t j = 0; j < constraint.size(); ++j) {
+                if (!operand(node, members[j * 2].string(),
+                        members[j * 2 + 1])) {
+                    return std::nullopt;
+                }
+            }
+        }
+    }
+
+    std::size_t index = _nodes.size();
+    _nodes.push_back(std::move(node));
+
+    if (kind != Kind::ARRAY && kind != Kind::OBJECT) {
+        return index;
+    }
+
+    data = schema.find("data");
+    if (data == nullptr) {
+        setError("Missing data for '{}'", type->string());
+        return std::nullopt;
+    }
+
+    if (kind == Kind::OBJECT && data->kind() != Kind::OBJECT) {
+        setError("Invalid data for 'object', got '{}'",
+            Program::name(data->kind()));
+        return std::nullopt;
+    }
+
+    return index;
+}
+
+bool Blueprint::Program::lower(const JSON::Value &root, std::size_t depth)
+{
+    // Fields are lowered depth first, as they would be recursively, with
+    // every container still missing some on a stack of frames
+    std::vector<Frame> frames;
+    const JSON::Value *next = &root;
+
+    while (true) {
+        const JSON::Value *data = nullptr;
+        std::optional<std::size_t> index = shape(*next, data);
+        if (!index.has_value()) {
+            return false;
+        }
+
+        Kind kind = _nodes[index.value()].kind;
+        if (data != nullptr && depth != 0 && frames.size() == depth) {
+            setError("Schema nested deeper than {} levels", depth);
+            return false;
+        }
+
+        if (kind == Kind::ARRAY) {
+            frames.push_back({.index = index.value(),
+                .remaining = 1,
+                .keys = {},
+                .children = data});
+            next = data;
+            continue;
+        }
+
+        if (kind == Kind::OBJECT && data->size() != 0) {
+            frames.push_back({.index = index.value(),
+                .remaining = data->size(),
+                .keys = {},
+                .children = data->children()});
+            next = &data->children()[1];
+            continue;
+        }
+
+        if (kind == Kind::OBJECT) {
+            _nodes[index.value()].keys.seal();
+        }
+
+        // Hands the node to its container, and every container it
+        // completes to the next one out
+        std::size_t child = index.value();
+        while (true) {
+            if (frames.empty()) {
+                return true;
+            }
+
+            Frame &frame = frames.back();
+            Node &parent = _nodes[frame.index];
+            if (parent.kind == Kind::ARRAY) {
+                parent.element = child;
+            } else {
+                std::size_t field = parent.fields.size();
+                parent.keys.insert(frame.children[field * 2].string());
+                parent.fields.push_back(child);
+            }
+
+            if (--frame.remaining != 0) {
+                next = &frame.children[parent.fields.size() * 2 + 1];
+                break;
+            }
+
+            if (parent.kind == Kind::OBJECT) {
+                parent.keys.seal();
+            }
+
+            child = frame.index;
+            frames.pop_back();
+        }
+    }
+}
+
+std::optional<std::size_t> Blueprint::Program::header(
+    Reader &reader, std::vector<std::string_view> &keys)
+{
+    std::optional<std::uint8_t> tag = reader.byte();
+    std::optional<std::uint64_t> count = reader.varint();
+    if (!tag.has_value() || !count.has_value()) {
+        setError("Truncated binary schema at byte {}", reader.position());
+        return std::nullopt;
+    }
+
+    if (tag.value() > static_cast<std::uint8_t>(Kind::OBJECT)) {
+        setError("Unknown schema type tag {}", tag.value());
+        return std::nullopt;
+    }
+
+    Node node;
+    node.kind = static_cast<Kind>(tag.value());
+
+    std::vector<JSON::Value> members;
+    for (std::uint64_t i = 0; i < count.value(); ++i) {
+        std::optional<std::uint8_t> constraint = reader.byte();
+        if (!constraint.has_value()) {
+            setError(
+                "Truncated binary schema at byte {}", reader.position());
+            return std::nullopt;
+        }
+
+        if (constraint.value() >= std::size(CONSTRAINTS)) {
+            setError("Invalid constraint tag {}", constraint.value());
+            return std::nullopt;
+        }
+
+        std::optional<JSON::Value> value = literal(reader, members, true);
+        if (!value.has_value()
+            || !operand(node, CONSTRAINTS[constraint.value()], *value)) {
+            return std::nullopt;
+        }
+    }
+
+    std::size_t index = _nodes.size();
+    _nodes.push_back(std::move(node));
+
+    if (tag.value() != static_cast<std::uint8_t>(Kind::OBJECT)) {
+        return index;
+    }
+
+    count = reader.varint();
+    if (!count.has_value()) {
+        setError("Truncated binary schema at byte {}", reader.position());
+        return std::nullopt;
+    }
+
+    // Every key is read before any field, so a count past the input fails
+    // before a node is built
+    for (std::uint64_t i = 0; i < count.value(); ++i) {
+        std::optional<std::uint64_t> size = reader.varint();
+        std::optional<std::string_view> key = size.has_value()
+            ? reader.bytes(static_cast<std::size_t>(size.value()))
+            : std::nullopt;
+        if (!key.has_value()) {
+            setError(
+                "Truncated binary schema at byte {}", reader.position());
+            return std::nullopt;
+        }
+
+        keys.push_back(key.value());
+    }
+
+    return index;
+}
+
+bool Blueprint::Program::decode(Reader &reader, std::size_t depth)
+{
+    // Nodes are written depth first, so every node read is the next child
+    // of the innermost container still missing some
+    std::vector<Frame> frames;
+
+    while (true) {
+        std::size_t offset = reader.position();
+        std::vector<std::string_view> keys;
+        std::optional<std::size_t> index = header(reader, keys);
+        if (!index.has_value()) {
+            return false;
+        }
+
+        Kind kind = _nodes[index.value()].kind;
+        if ((kind == Kind::ARRAY || kind == Kind::OBJECT) && depth != 0
+            && frames.size() == depth) {
+            setError("Schema nested deeper than {} levels at byte {}", depth,
+                offset);
+            return false;
+        }
+
+        if (kind == Kind::ARRAY || (kind == Kind::OBJECT && !keys.empty())) {
+            std::size_t remaining = kind == Kind::ARRAY ? 1 : keys.size();
+            frames.push_back({.index = index.value(),
+                .remaining = remaining,
+                .keys = std::move(keys)});
+            continue;
+        }
+
+        if (kind == Kind::OBJECT) {
+            _nodes[index.value()].keys.seal();
+        }
+
+        // Hands the node to its container, and every container it
+        // completes to the next one out
+        std::size_t child = index.value();
+        while (true) {
+            if (frames.empty()) {
+                return true;
+            }
+
+            Frame &frame = frames.back();
+            Node &parent = _nodes[frame.index];
+            if (parent.kind == Kind::ARRAY) {
+                parent.element = child;
+            } else {
+                parent.keys.insert(frame.keys[parent.fields.size()]);
+                parent.fields.push_back(child);
+            }
+
+            if (--frame.remaining != 0) {
+                break;
+            }
+
+            if (parent.kind == Kind::OBJECT) {
+                parent.keys.seal();
+            }
+
+            child = frame.index;
+            frames.pop_back();
+        }
+    }
+}
+
+std::optional<Blueprint::JSON::Value> Blueprint::Program::literal(
+    Reader &reader, std::vector<JSON::Value> &members, bool list)
+{
+    using Tag = Reader::Tag;
+
+    std::optional<std::uint8_t> tag = reader.byte();
+    if (!tag.has_value()) {
+        setError("Truncated binary schema at byte {}", reader.position());
+        return std::nullopt;
+    }
+
+    switch (static_cast<Tag>(tag.value())) {
+        case Tag::INTEGER:
+        case Tag::REAL: {
+            std::optional<JSON::Number> number =
+                reader.number(static_cast<Tag>(tag.value()));
+            if (!number.has_value()) {
+                break;
+            }
+
+            // JSON has no literal for them either
+            if (!number->integral() && !std::isfinite(number->real())) {
+                setError("Non-finite number in binary schema at byte {}",
+                    reader.position() - sizeof(double));
+                return std::nullopt;
+            }
+
+            return number->integral()
+                ? JSON::Value::fromInteger(number->integer())
+                : JSON::Value::fromNumber(number->real());
+        }
+        case Tag::STRING: {
+            std::optional<std::uint64_t> size = reader.varint();
+            std::optional<std::string_view> text = size.has_value()
+                ? reader.bytes(static_cast<std::size_t>(size.value()))
+                : std::nullopt;
+            if (!text.has_value()) {
+                break;
+            }
+
+            return JSON::Value::fromString(text.value());
+        }
+        case Tag::FALSE: return JSON::Value::fromBoolean(false);
+        case Tag::TRUE: return JSON::Value::fromBoolean(true);
+        case Tag::NULL_VALUE: return JSON::Value::fromNull();
+        case Tag::LIST: {
+            if (!list) {
+                setError("Nested list in binary schema at byte {}",
+                    reader.position() - 1);
+                return std::nullopt;
+            }
+
+            std::optional<std::uint64_t> count = reader.varint();
+            if (!count.has_value()) {
+                break;
+            }
+
+            members.clear();
+            for (std::uint64_t i = 0; i < count.value(); ++i) {
+                std::optional<JSON::Value> member =
+                    literal(reader, members, false);
+                if (!member.has_value()) {
+                    return std::nullopt;
+                }
+
+                members.push_back(member.value());
+            }
+
+            if (members.size() > UINT32_MAX) {
+                setError("List of {} literals is too large", members.size());
+                return std::nullopt;
+            }
+
+            return JSON::Value::fromArray(
+                members.data(), static_cast<std::uint32_t>(members.size()));
+        }
+        default:
+            setError("Invalid operand tag {} at byte {}", tag.value(),
+                reader.position() - 1);
+            return std::nullopt;
+    }
+
+    setError("Truncated binary schema at byte {}", reader.position());
+
+    return std::nullopt;
+}
+
+static std::optional<Blueprint::Program::Opcode> opcode(std::string_view name)
+{
+    using Opcode = Blueprint::Program::Opcode;
+
+    static const std::unordered_map<std::string, Opcode,
+        Blueprint::Program::KeyHash, std::equal_to<>>
+        opcodes = {
+            {"MIN_VALUE", Opcode::MIN_VALUE},
+            {"MAX_VALUE", Opcode::MAX_VALUE},
+            {"MIN_LENGTH", Opcode::MIN_LENGTH},
+            {"MAX_LENGTH", Opcode::MAX_LENGTH},
+            {"ENUM", Opcode::ENUM},
+            {"VALUES", Opcode::VALUES},
+            {"REQUIRED", Opcode::REQUIRED},
+        };
+
+    auto it = opcodes.find(name);
+    if (it == opcodes.end()) {
+        return std::nullopt;
+    }
+
+    return it->second;
+}
+
+static bool applies(
+    Blueprint::Program::Opcode opcode, Blueprint::Program::Kind kind)
+{
+    using Kind = Blueprint::Program::Kind;
+    using Opcode = Blueprint::Program::Opcode;
+
+    switch (opcode) {
+        case Opcode::MIN_VALUE:
+        case Opcode::MAX_VALUE: return kind == Kind::NUMBER;
+        case Opcode::MIN_LENGTH:
+        case Opcode::MAX_LENGTH:
+            return kind == Kind::STRING || kind == Kind::ARRAY;
+        case Opcode::ENUM: return kind == Kind::STRING || kind == Kind::OBJECT;
+        case Opcode::VALUES: return kind == Kind::NUMBER || kind == Kind::ARRAY;
+        default: return true;
+    }
+}
+
+bool Blueprint::Program::operand(
+    Node &node, std::string_view name, const JSON::Value &value)
+{
+    if (name == "ADDITIONAL_PROPERTIES") {
+        if (node.kind != Kind::OBJECT) {
+            setError("Constraint {} does not apply to '{}'", name,
+                Program::name(node.kind));
+            return false;
+        }
+
+        if (value.kind() != Kind::BOOLEAN) {
+            setError("Invalid {} constraint of type '{}'", name,
+                Program::name(value.kind()));
+            return false;
+        }
+
+        node.open = value.boolean();
+        return true;
+    }
+
+    std::optional<Opcode> opcode = ::opcode(name);
+    if (!opcode.has_value()) {
+        setError("Invalid constraint '{}'", name);
+        return false;
+    }
+
+    if (!applies(opcode.value(), node.kind)) {
+        setError("Constraint {} does not apply to '{}'", name,
+            Program::name(node.kind));
+        return false;
+    }
+
+    Instruction instruction = {
+        .opcode = opcode.value(), .operand = 0, .bound = {}};
+
+    if (opcode == Opcode::REQUIRED) {
+        if (value.kind() != Kind::BOOLEAN) {
+            setError("Invalid REQUIRED constraint of type '{}'",
+                Program::name(value.kind()));
+            return false;
+        }
+
+        if (value.boolean()) {
+            node.checks.push_back(instruction);
+        }
+
+        return true;
+    }
+
+    if (opcode == Opcode::ENUM || opcode == Opcode::VALUES) {
+        std::optional members = literals(name, value);
+        if (!members.has_value()) {
+            return false;
+        }
+
+        // No object is ever a member of an ENUM
+        if (node.kind == Kind::OBJECT) {
+            instruction.opcode = Opcode::REJECT;
+            node.checks.push_back(instruction);
+            return true;
+        }
+
+        instruction.operand = node.sets.size();
+        node.sets.push_back(std::move(members.value()));
+        (node.kind == Kind::ARRAY ? node.elements : node.checks)
+            .push_back(instruction);
+        return true;
+    }
+
+    if (value.kind() != Kind::NUMBER) {
+        setError("Invalid {} constraint of type '{}'", name,
+            Program::name(value.kind()));
+        return false;
+    }
+
+    if (opcode == Opcode::MIN_VALUE || opcode == Opcode::MAX_VALUE) {
+        instruction.bound = value.toNumber();
+        node.checks.push_back(instruction);
+        return true;
+    }
+
+    // Lengths are whole and fit a size_t, anything else would be truncated
+    double length = value.number();
+    bool whole = value.integral()
+        ? value.integer() >= 0
+        : length >= 0 && length == std::floor(length) && length < 0x1p64;
+    if (!whole) {
+        setError("Invalid {} constraint '{}'", name, length);
+        return false;
+    }
+
+    instruction.operand = value.integral()
+        ? static_cast<std::size_t>(value.integer())
+        : static_cast<std::size_t>(length);
+    (node.kind == Kind::ARRAY ? node.sizes : node.checks)
+        .push_back(instruction);
+    return true;
+}
+
+std::optional<Blueprint::Set> Blueprint::Program::literals(
+    std::string_view name, const JSON::Value &value)
+{
+    if (value.kind() != Kind::ARRAY) {
+        setError("Invalid {} constraint of type '{}'", name,
+            Program::name(value.kind()));
+        return std::nullopt;
+    }
+
+    Set literals;
+    for (std::size_t i = 0; i < value.size(); ++i) {
+        const JSON::Value &member = value.children()[i];
+
+        switch (member.kind()) {
+            case Kind::NUMBER:
+                literals.insert(member.kind(), member.toNumber(), "");
+                break;
+            case Kind::STRING:
+                literals.insert(member.kind(), {}, member.string());
+                break;
+            case Kind::BOOLEAN:
+                literals.insert(
+                    member.kind(), {}, member.boolean() ? "true" : "false");
+                break;
+            case Kind::NULL_VALUE:
+                literals.insert(member.kind(), {}, "");
+                break;
+            default:
+                setError("Unsupported {} member of type '{}'", name,
+                    Program::name(member.kind()));
+                return std::nullopt;
+        }
+    }
+
+    literals.seal();
+
+    return literals;
+}
+
+const Blueprint::Program::Node &Blueprint::Program::root() const
+{
+    return _nodes.front();
+}
+
+const Blueprint::Program::Node &Blueprint::Program::operator[](
+    std::size_t index) const
+{
+    return _nodes[index];
+}
+
+std::size_t Blueprint::Program::index(const Node &node) const
+{
+    return static_cast<std::size_t>(&node - _nodes.data());
+}
+
+void Blueprint::Program::retain() const
+{
+    _references.fetch_add(1, std::memory_order_relaxed);
+}
+
+bool Blueprint::Program::release() const
+{
+    return _references.fetch_sub(1, std::memory_order_acq_rel) == 1;
+}
+
+const std::string &Blueprint::Program::getError() const
+{
+    return _error;
+}
+
+void Blueprint::Program::attach(std::unique_ptr<Library> library)
+{
+    _library = std::move(library);
+}
+
+const Blueprint::Plugin *Blueprint::Program::plugin() const
+{
+    return _library == nullptr ? nullptr : _library->plugin();
+}
+
+std::optional<Blueprint::Program::Kind> Blueprint::Program::kind(
+    std::string_view name)
+{
+    static const std::unordered_map<std::string, Kind, KeyHash,
+        std::equal_to<>>
+        kinds = {
+            {"number", Kind::NUMBER},
+            {"string", Kind::STRING},
+            {"boolean", Kind::BOOLEAN},
+            {"null", Kind::NULL_VALUE},
+            {"array", Kind::ARRAY},
+            {"object", Kind::OBJECT},
+        };
+
+    auto it = kinds.find(name);
+    if (it == kinds.end()) {
+        return std::nullopt;
+    }
+
+    return it->second;
+}
+
+const char *Blueprint::Program::name(Kind kind)
+{
+    switch (kind) {
+        case Kind::NUMBER: return "number";
+        case Kind::STRING: return "string";
+        case Kind::BOOLEAN: return "boolean";
+        case Kind::NULL_VALUE: return "null";
+        case Kind::ARRAY: return "array";
+        case Kind::OBJECT: return "object";
+    }
+
+    return "unknown";
+}
@@ -0,0 +1,105 @@
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <string_view>
+
+#include "JSON/Number.hpp"
+#include "Reader.hpp"
+
+Blueprint::Reader::Reader(std::string_view data) : _data(data) {}
+
+std::optional<std::uint8_t> Blueprint::Reader::byte()
+{
+    if (_position >= _data.size()) {
+        return std::nullopt;
+    }
+
+    return static_cast<std::uint8_t>(_data[_position++]);
+}
+
+std::optional<std::uint64_t> Blueprint::Reader::varint()
+{
+    std::uint64_t value = 0;
+
+    for (unsigned shift = 0; shift < 64; shift += 7) {
+        std::optional<std::uint8_t> next = byte();
+        if (!next.has_value()) {
+            return std::nullopt;
+        }
+
+        // The tenth byte only has room for the top bit
+        std::uint64_t bits = next.value() & 0x7f;
+        if (shift == 63 && bits > 1) {
+            return std::nullopt;
+        }
+
+        value |= bits << shift;
+        if ((next.value() & 0x80) == 0) {
+            return value;
+        }
+    }
+
+    return std::nullopt;
+}
+
+std::optional<std::string_view> Blueprint::Reader::bytes(std::size_t size)
+{
+    if (size > _data.size() - _position) {
+        return std::nullopt;
+    }
+
+    std::string_view bytes = _data.substr(_position, size);
+    _position += size;
+
+    return bytes;
+}
+
+std::optional<Blueprint::JSON::Number> Blueprint::Reader::number(Tag tag)
+{
+    if (tag == Tag::INTEGER) {
+        std::optional<std::uint64_t> zigzag = varint();
+        if (!zigzag.has_value()) {
+            return std::nullopt;
+        }
+
+        std::uint64_t bits = zigzag.value();
+        return JSON::Number::fromInteger(
+            static_cast<std::int64_t>((bits >> 1) ^ (~(bits & 1) + 1)));
+    }
+
+    if (tag != Tag::REAL) {
+        return std::nullopt;
+    }
+
+    std::optional<std::string_view> raw = bytes(sizeof(double));
+    if (!raw.has_value()) {
+        return std::nullopt;
+    }
+
+    std::uint64_t bits = 0;
+    for (std::size_t i = 0; i < sizeof(double); ++i) {
+        bits |= static_cast<std::uint64_t>(
+                    static_cast<std::uint8_t>((*raw)[i]))
+            << (i * 8);
+    }
+
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+
+    return JSON::Number::fromReal(value);
+}
+
+std::size_t Blueprint::Reader::position() const
+{
+    return _position;
+}
+
+bool Blueprint::Reader::done() const
+{
+    return _position == _data.size();
+}
+
+bool Blueprint::Reader::matches(std::string_view data)
+{
+    return !data.empty() && static_cast<std::uint8_t>(data[0]) == MAGIC;
+}
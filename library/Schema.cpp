@@ -1,399 +1,437 @@
+#include <algorithm>
+#include <cstring>
 #include <memory>
 #include <string>
-
-#include "JSON/primitives/Array.hpp"
-#include "JSON/primitives/Number.hpp"
-#include "JSON/primitives/Object.hpp"
-#include "JSON/primitives/String.hpp"
+#include <thread>
+#include <vector>
+
+#include "Context.hpp"
+#include "Error.hpp"
+#include "Library.hpp"
+#include "Mapping.hpp"
+#include "Plugin.hpp"
+#include "Program.hpp"
 #include "Schema.hpp"
-#include "interfaces/IPrimitive.hpp"
 
-Blueprint::Schema::Schema()
+// Message of a record that passed
+static const std::string PASSED;
+
+Blueprint::Schema::~Schema()
 {
-    _callbacks = {
-        {
-            "MIN_VALUE",
-            std::bind(&Blueprint::Schema::minValue, this,
-                std::placeholders::_1, std::placeholders::_2),
-        },
-        {
-            "MAX_VALUE",
-            std::bind(&Blueprint::Schema::maxValue, this,
-                std::placeholders::_1, std::placeholders::_2),
-        },
-        {
-            "MIN_LENGTH",
-            std::bind(&Blueprint::Schema::minLength, this,
-                std::placeholders::_1, std::placeholders::_2),
-        },
-        {
-            "MAX_LENGTH",
-            std::bind(&Blueprint::Schema::maxLength, this,
-                std::placeholders::_1, std::placeholders::_2),
-        },
-        {
-            "ENUM",
-            std::bind(&Blueprint::Schema::enumValue, this,
-                std::placeholders::_1, std::placeholders::_2),
-        },
-        {
-            "REQUIRED",
-            std::bind(&Blueprint::Schema::required, this,
-                std::placeholders::_1, std::placeholders::_2),
-        },
-        {
-            "VALUES",
-            std::bind(&Blueprint::Schema::exactValue, this,
-                std::placeholders::_1, std::placeholders::_2),
-        },
-    };
+    drop();
 }
 
-bool Blueprint::Schema::verify(std::string schema, std::string data)
+void Blueprint::Schema::reset()
 {
-    std::shared_ptr schemaObject =
-        Schema::as<JSON::Primitives::Object>(_parser.parse(schema));
-    if (schemaObject == nullptr) {
-        setError("Invalid schema. Expected object, got '{}'", schema);
-        return false;
+    _error.clear();
+    _message.clear();
+    _formatted = false;
+    _failures.clear();
+    _batch = 0;
+}
+
+void Blueprint::Schema::hold(const Program &program)
+{
+    if (_program == &program) {
+        return;
+    }
+
+    program.retain();
+    drop();
+    _program = &program;
+}
+
+void Blueprint::Schema::drop()
+{
+    if (_program != nullptr && _program->release()) {
+        delete _program;
     }
 
-    std::shared_ptr dataObject = _parser.parse(data);
-    if (dataObject == nullptr) {
-        setError("Invalid data. Expected object, got '{}'", data);
+    _program = nullptr;
+}
+
+bool Blueprint::Schema::verify(std::string_view schema, std::string_view data)
+{
+    Program *program = compile(schema);
+    if (program == nullptr) {
         return false;
     }
 
-    try {
-        return handle(schemaObject, dataObject);
-    } catch (const std::out_of_range &error) {
-        setError("Out of bounds access: {}", error.what());
+    // A failure holds the program past this call
+    bool valid = verify(*program, data);
+    if (program->release()) {
+        delete program;
+    }
+
+    return valid;
+}
+
+bool Blueprint::Schema::verify(const Program &program, std::string_view data)
+{
+    reset();
+
+    if (!_context.verify(program, data)) {
+        _error = _context.getError();
+        hold(program);
         return false;
     }
+
+    return true;
 }
 
-// TODO(jabolo): Improve error messages to include the invalid value path
-bool Blueprint::Schema::handle(
-    std::shared_ptr<JSON::Primitives::Object> schema,
-    std::shared_ptr<Interfaces::IPrimitive> data)
+bool Blueprint::Schema::verifyPacked(
+    const Program &program, std::string_view data)
 {
-    std::string type = data->getType();
+    reset();
 
-    if (type == "array") {
-        std::shared_ptr primitive = Schema::as<JSON::Primitives::Array>(data);
-        if (primitive == nullptr) {
-            setError("Invalid array '{}'", data->toString());
-            return false;
-        }
+    if (!_context.verifyPacked(program, data)) {
+        _error = _context.getError();
+        hold(program);
+        return false;
+    }
 
-        std::shared_ptr constraints =
-            Schema::as<JSON::Primitives::Array>((*schema)["constraints"]);
-        if (constraints == nullptr) {
-            setError("Invalid constraints '{}'", schema->toString());
-            return false;
-        }
+    return true;
+}
 
-        std::shared_ptr innerSchema =
-            Schema::as<JSON::Primitives::Object>((*schema)["data"]);
-        if (innerSchema == nullptr) {
-            setError("Invalid innerSchema '{}'", schema->toString());
-            return false;
-        }
+std::size_t Blueprint::Schema::workers(std::size_t count, std::size_t grain)
+{
+    std::size_t cores =
+        std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+    // More threads than this only add switches, and enough of them fail to
+    // spawn at all
+    std::size_t threads = _threads != 0
+        ? std::min(_threads, cores * OVERSUBSCRIPTION)
+        : cores;
+
+    if (threads == 1 || count <= grain) {
+        return 1;
+    }
 
-        if (!check(constraints, data)) {
-            return false;
+    // The pool and its worker contexts are only created on first use
+    if (_pool == nullptr || _pool->size() != threads) {
+        _pool = std::make_unique<Pool>(threads);
+        for (const std::unique_ptr<Context> &worker : _workers) {
+            _retired.merge(worker->getStats());
         }
-
-        for (const auto &value : primitive->values()) {
-            if (!handle(innerSchema, value)) {
-                return false;
-            }
+        _workers.clear();
+        for (std::size_t i = 1; i < threads; ++i) {
+            _workers.push_back(std::make_unique<Context>());
         }
+    }
 
-        return true;
+    for (std::unique_ptr<Context> &worker : _workers) {
+        worker->setMode(_mode);
+        worker->setDepth(_depth);
     }
 
-    if (type == "object") {
-        std::shared_ptr primitive = Schema::as<JSON::Primitives::Object>(data);
-        if (primitive == nullptr) {
-            setError("Invalid object '{}'", data->toString());
-            return false;
-        }
+    return threads;
+}
 
-        std::shared_ptr constraints =
-            Schema::as<JSON::Primitives::Array>((*schema)["constraints"]);
-        if (constraints == nullptr) {
-            setError("Invalid constraints '{}'", schema->toString());
-            return false;
-        }
+void Blueprint::Schema::parallel(
+    std::size_t count, std::size_t grain, const Pool::Task &task)
+{
+    if (workers(count, grain) == 1) {
+        task(0, 0, count);
+        return;
+    }
 
-        std::shared_ptr innerSchema =
-            Schema::as<JSON::Primitives::Object>((*schema)["data"]);
-        if (innerSchema == nullptr) {
-            setError("Invalid innerSchema '{}'", schema->toString());
-            return false;
-        }
+    _pool->run(count, grain, task);
+}
 
-        if (!check(constraints, data)) {
-            return false;
-        }
+Blueprint::Context &Blueprint::Schema::worker(std::size_t index)
+{
+    return index == 0 ? _context : *_workers[index - 1];
+}
 
-        for (const auto &key : JSON::Primitives::Object::keys(primitive)) {
-            std::shared_ptr objectSchema =
-                Schema::as<JSON::Primitives::Object>((*innerSchema)[key]);
-            if (!handle(objectSchema, (*primitive)[key])) {
-                return false;
+bool Blueprint::Schema::verify(const Program &program,
+    const char *const *documents, const std::size_t *lengths,
+    std::size_t count, std::uint8_t *results)
+{
+    reset();
+    _batch = count;
+    _rejections.resize(workers(count, BATCH_GRAIN));
+
+    parallel(count, BATCH_GRAIN,
+        [&](std::size_t index, std::size_t begin, std::size_t end) {
+            Context &context = worker(index);
+
+            for (std::size_t i = begin; i < end; ++i) {
+                // A missing document is read as an empty one
+                std::string_view data = documents[i] == nullptr
+                    ? std::string_view()
+                    : std::string_view(documents[i], lengths[i]);
+                results[i] = context.verify(program, data) ? 1 : 0;
+                if (results[i] == 0) {
+                    _rejections[index].push_back({.index = i,
+                        .error = context.getError(),
+                        .message = {}});
+                }
             }
-        }
+        });
 
-        return true;
+    for (std::vector<Rejection> &rejections : _rejections) {
+        _failures.insert(
+            _failures.end(), rejections.begin(), rejections.end());
+        rejections.clear();
     }
 
-    std::shared_ptr constraints =
-        Schema::as<JSON::Primitives::Array>((*schema)["constraints"]);
-    if (constraints == nullptr) {
-        setError("Invalid constraints '{}'", schema->toString());
-        return false;
+    std::sort(_failures.begin(), _failures.end(),
+        [](const Rejection &left, const Rejection &right) {
+            return left.index < right.index;
+        });
+
+    if (!_failures.empty()) {
+        setError("{} of {} records are invalid", _failures.size(), count);
+        hold(program);
     }
 
-    return check(constraints, data);
+    return _failures.empty();
 }
 
-bool Blueprint::Schema::minValue(std::shared_ptr<Interfaces::IPrimitive> data,
-    std::shared_ptr<JSON::Primitives::Object> schema)
+bool Blueprint::Schema::verifyFile(
+    const Program &program, const std::string &path)
 {
-    int primitive = std::stoi(data->toString());
-    int constraint = std::stoi((*schema)["MIN_VALUE"]->toString());
-
-    if (primitive < constraint) {
-        setError("Value '{}' is less than '{}'", primitive, constraint);
+    Mapping mapping;
+    if (!mapping.open(path)) {
+        reset();
+        setError("{}", mapping.getError());
         return false;
     }
 
-    return true;
+    // A file is streamed whatever the mode, a tree of a large dump would
+    // hold a value for every token of it
+    _context.setMode(Mode::STREAM);
+    bool valid = verify(program, mapping.view());
+    _context.setMode(_mode);
+
+    return valid;
 }
 
-bool Blueprint::Schema::maxValue(std::shared_ptr<Interfaces::IPrimitive> data,
-    std::shared_ptr<JSON::Primitives::Object> schema)
+bool Blueprint::Schema::verifyLines(
+    const Program &program, std::string_view data)
 {
-    int primitive = std::stoi(data->toString());
-    int constraint = std::stoi((*schema)["MAX_VALUE"]->toString());
+    reset();
+    _records.clear();
+    _bitmap.clear();
+    _lines.clear();
+
+    // Raw newlines cannot appear inside JSON strings, so every one of them
+    // ends a record
+    for (std::size_t start = 0; start < data.size();) {
+        const void *newline =
+            std::memchr(data.data() + start, '\n', data.size() - start);
+        std::size_t end = newline == nullptr
+            ? data.size()
+            : static_cast<const char *>(newline) - data.data();
+        std::string_view line = data.substr(start, end - start);
+
+        if (line.find_first_not_of(" \t\r") != std::string_view::npos) {
+            _records.push_back(
+                {.offset = start, .size = end - start, .code = Code::NONE});
+        }
 
-    if (primitive > constraint) {
-        setError("Value '{}' is greater than '{}'", primitive, constraint);
-        return false;
+        start = end + 1;
     }
 
-    return true;
-}
-
-bool Blueprint::Schema::minLength(std::shared_ptr<Interfaces::IPrimitive> data,
-    std::shared_ptr<JSON::Primitives::Object> schema)
-{
-    std::string type = data->getType();
+    // The first failure of every worker, merged once all of them are done
+    std::vector<Rejection> firsts(workers(_records.size(), LINES_GRAIN),
+        {.index = _records.size(), .error = {}, .message = {}});
 
-    if (type == "array") {
-        std::shared_ptr primitive = Schema::as<JSON::Primitives::Array>(data);
-        if (primitive == nullptr) {
-            setError("Invalid array '{}'", data->toString());
-            return false;
-        }
+    parallel(_records.size(), LINES_GRAIN,
+        [&](std::size_t index, std::size_t begin, std::size_t end) {
+            Context &context = worker(index);
 
-        std::size_t length = std::stoll((*schema)["MIN_LENGTH"]->toString());
-        std::vector values = primitive->values();
+            for (std::size_t i = begin; i < end; ++i) {
+                Record &record = _records[i];
+                std::string_view line = data.substr(record.offset, record.size);
+                if (context.verify(program, line)) {
+                    continue;
+                }
 
-        if (values.size() < length) {
-            setError("Minimum size expected {} elements, got {}", length,
-                values.size());
-            return false;
+                record.code = context.getCode();
+                if (i < firsts[index].index) {
+                    firsts[index] = {
+                        .index = i, .error = context.getError(), .message = {}};
+                }
+            }
+        });
+
+    _bitmap.resize((_records.size() + 7) / 8);
+    for (std::size_t i = 0; i < _records.size(); ++i) {
+        const Record &record = _records[i];
+        if (record.code == Code::NONE) {
+            _bitmap[i / 8] |= static_cast<std::uint8_t>(1 << i % 8);
+            continue;
         }
 
-        return true;
+        _lines.push_back({.record = i, .offset = record.offset,
+            .code = record.code, .reserved = {}});
     }
 
-    if (type == "string") {
-        std::shared_ptr primitive = Schema::as<JSON::Primitives::String>(data);
-        if (primitive == nullptr) {
-            setError("Invalid string '{}'", data->toString());
-            return false;
-        }
+    _report = {.records = _records.size(), .failed = _lines.size(),
+        .bitmap = _bitmap.data(), .failures = _lines.data()};
 
-        std::size_t length = std::stoll((*schema)["MIN_LENGTH"]->toString());
-        std::size_t size = data->toString().size();
+    if (!_lines.empty()) {
+        auto first = std::min_element(firsts.begin(), firsts.end(),
+            [](const Rejection &left, const Rejection &right) {
+                return left.index < right.index;
+            });
 
-        if (size < length) {
-            setError("Minimum size expected {}, got {}", length, size);
-            return false;
+        // Located again within the whole buffer
+        _error = first->error;
+        if (_error.offset != Error::NO_OFFSET) {
+            _error.offset += _records[first->index].offset;
         }
+        _error.locate(data);
 
-        return true;
+        setError("{} of {} records are invalid, first is record {}: ",
+            _lines.size(), _records.size(), first->index);
+        hold(program);
     }
 
-    setError("Expected 'array' or 'string', got {}", type);
-    return false;
+    return _lines.empty();
 }
 
-bool Blueprint::Schema::maxLength(std::shared_ptr<Interfaces::IPrimitive> data,
-    std::shared_ptr<JSON::Primitives::Object> schema)
+Blueprint::Program *Blueprint::Schema::compile(std::string_view schema)
 {
-    std::string type = data->getType();
+    reset();
 
-    if (type == "array") {
-        std::shared_ptr primitive = Schema::as<JSON::Primitives::Array>(data);
-        if (primitive == nullptr) {
-            setError("Invalid array '{}'", data->toString());
-            return false;
-        }
-
-        std::size_t length = std::stoll((*schema)["MAX_LENGTH"]->toString());
-        std::vector values = primitive->values();
-
-        if (values.size() > length) {
-            setError("Maximum size expected {} elements, got {}", length,
-                values.size());
-            return false;
-        }
-
-        return true;
+    std::unique_ptr<Program> program(new (std::nothrow) Program());
+    if (program == nullptr) {
+        setError("Failed to allocate program");
+        return nullptr;
     }
 
-    if (type == "string") {
-        std::shared_ptr primitive = Schema::as<JSON::Primitives::String>(data);
-        if (primitive == nullptr) {
-            setError("Invalid string '{}'", data->toString());
-            return false;
-        }
+    // Schemas are held to the nesting limit of the documents they validate
+    if (!program->load(schema, _depth)) {
+        setError("{}", program->getError());
+        return nullptr;
+    }
 
-        std::size_t length = std::stoll((*schema)["MAX_LENGTH"]->toString());
-        std::size_t size = data->toString().size() - 2;
+    return program.release();
+}
 
-        if (size > length) {
-            setError("Maximum size expected {}, got {}", length, size);
-            return false;
-        }
+Blueprint::Program *Blueprint::Schema::compilePlugin(
+    const std::string &path, std::string_view schema)
+{
+    reset();
 
-        return true;
+    std::unique_ptr<Library> library(new (std::nothrow) Library());
+    if (library == nullptr) {
+        setError("Failed to allocate library");
+        return nullptr;
     }
 
-    setError("Expected 'array' or 'string', got {}", type);
-    return false;
-}
+    if (!library->open(path)) {
+        setError("{}", library->getError());
+        return nullptr;
+    }
 
-bool Blueprint::Schema::enumValue(std::shared_ptr<Interfaces::IPrimitive> data,
-    std::shared_ptr<JSON::Primitives::Object> schema)
-{
-    std::shared_ptr values =
-        Schema::as<JSON::Primitives::Array>((*schema)["ENUM"]);
-    if (values == nullptr) {
-        setError("Invalid ENUM constraint '{}'", schema->toString());
-        return false;
+    const Plugin *plugin = library->plugin();
+    std::string_view source(plugin->schema, plugin->size);
+    if (!schema.empty() && schema != source) {
+        setError("Plugin '{}' was generated from another schema", path);
+        return nullptr;
     }
 
-    for (const auto &value : values->values()) {
-        if (data->toString() == value->toString()) {
-            return true;
-        }
+    // Nodes of the same schema take over whatever the plugin turns down
+    Program *program = compile(source);
+    if (program != nullptr) {
+        program->attach(std::move(library));
     }
 
-    setError("Value '{}' not in ENUM", data->toString());
-    return false;
+    return program;
 }
 
-bool Blueprint::Schema::required(
-    [[maybe_unused]] std::shared_ptr<Interfaces::IPrimitive> data,
-    [[maybe_unused]] std::shared_ptr<JSON::Primitives::Object> schema)
+void Blueprint::Schema::setThreads(std::size_t threads)
 {
-    setError("{} not implemented", __func__);
-    return false;
+    _threads = threads;
 }
 
-bool Blueprint::Schema::exactValue(
-    std::shared_ptr<Interfaces::IPrimitive> data,
-    std::shared_ptr<JSON::Primitives::Object> schema)
+void Blueprint::Schema::setMode(Mode mode)
 {
-    std::shared_ptr array = Schema::as<JSON::Primitives::Array>(data);
-    if (array != nullptr) {
-        std::shared_ptr values =
-            Schema::as<JSON::Primitives::Array>((*schema)["VALUES"]);
-        if (values == nullptr) {
-            setError("Invalid VALUES constraint '{}'", schema->toString());
-            return false;
-        }
-
-        for (const auto &value : array->values()) {
-            bool found = false;
-            for (const auto &constraint : values->values()) {
-                if (value->toString() == constraint->toString()) {
-                    found = true;
-                    break;
-                }
-            }
-
-            if (!found) {
-                setError("Value {} not in VALUES", value->toString());
-                return false;
-            }
-        }
+    _mode = mode;
+    _context.setMode(mode);
+}
 
-        return true;
-    }
+void Blueprint::Schema::setDepth(std::size_t depth)
+{
+    _depth = depth;
+    _context.setDepth(depth);
+}
 
-    std::shared_ptr number = Schema::as<JSON::Primitives::Number>(data);
-    if (number != nullptr) {
-        double primitive = std::stod(number->toString());
-        std::shared_ptr values =
-            Schema::as<JSON::Primitives::Array>((*schema)["VALUES"]);
-        if (values == nullptr) {
-            setError("Invalid VALUES constraint '{}'", schema->toString());
-            return false;
-        }
+std::size_t Blueprint::Schema::getDepth() const
+{
+    return _depth;
+}
 
-        for (const auto &value : values->values()) {
-            double constraint = std::stod(value->toString());
-            if (primitive == constraint) {
-                return true;
-            }
-        }
+const Blueprint::Report &Blueprint::Schema::getReport() const
+{
+    return _report;
+}
 
-        setError("Value {} not in VALUES", data->toString());
-        return false;
+Blueprint::Stats Blueprint::Schema::getStats() const
+{
+    Stats stats = _retired;
+    stats.merge(_context.getStats());
+    for (const std::unique_ptr<Context> &worker : _workers) {
+        stats.merge(worker->getStats());
     }
 
-    setError("Invalid type '{}'", data->getType());
-    return false;
+    return stats;
 }
 
-template <typename T>
-std::shared_ptr<T> Blueprint::Schema::as(
-    std::shared_ptr<Interfaces::IPrimitive> primitive)
+void Blueprint::Schema::resetStats()
 {
-    return std::dynamic_pointer_cast<T>(primitive);
+    _retired = {};
+    _context.resetStats();
+    for (std::unique_ptr<Context> &worker : _workers) {
+        worker->resetStats();
+    }
 }
 
-const std::string &Blueprint::Schema::getError() const
+Blueprint::Verdict Blueprint::Schema::getVerdict(bool valid) const
 {
-    return _error;
+    return {.valid = static_cast<std::uint8_t>(valid ? 1 : 0),
+        .code = _error.code(),
+        .reason = _error.reason,
+        .reserved = {},
+        .offset = _error.offset,
+        .line = _error.line,
+        .column = _error.column};
 }
 
-bool Blueprint::Schema::check(
-    std::shared_ptr<JSON::Primitives::Array> constraints,
-    std::shared_ptr<Interfaces::IPrimitive> data)
+const std::string &Blueprint::Schema::getMessage() const
 {
-    for (const auto &value : constraints->values()) {
-        auto object = Schema::as<JSON::Primitives::Object>(value);
-        auto keys = JSON::Primitives::Object::keys(object);
-
-        for (const std::string &key : keys) {
-            auto cb = _callbacks.find(key);
-            if (cb == _callbacks.end()) {
-                setError("Invalid constraint '{}'", key);
-                return false;
-            }
-            if (!cb->second(data, object)) {
-                return false;
-            }
+    if (!_formatted) {
+        _text = _message;
+        if (_error.reason != Reason::NONE) {
+            _text += _error.format(_program);
         }
+        _formatted = true;
     }
 
-    return true;
+    return _text;
+}
+
+const std::string *Blueprint::Schema::getMessage(std::size_t index) const
+{
+    if (index >= _batch) {
+        return nullptr;
+    }
+
+    auto failure = std::lower_bound(_failures.begin(), _failures.end(), index,
+        [](const Rejection &rejection, std::size_t index) {
+            return rejection.index < index;
+        });
+
+    if (failure == _failures.end() || failure->index != index) {
+        return &PASSED;
+    }
+
+    if (failure->message.empty()) {
+        failure->message = failure->error.format(_program);
+    }
+
+    return &failure->message;
 }
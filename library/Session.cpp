@@ -0,0 +1,243 @@
+#include <algorithm>
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "Error.hpp"
+#include "JSON/Token.hpp"
+#include "Program.hpp"
+#include "Session.hpp"
+
+// Bytes that end a number or literal
+static constexpr std::string_view DELIMITERS = " \t\n\r{}[]:,\"";
+
+static constexpr std::string_view LITERALS[] = {"null", "true", "false"};
+
+// Whether a word cut by the end of a chunk can still become a token
+static bool unfinished(std::string_view word)
+{
+    for (std::string_view literal : LITERALS) {
+        if (literal.starts_with(word)) {
+            return true;
+        }
+    }
+
+    return word.find_first_not_of("0123456789+-.eE")
+        == std::string_view::npos;
+}
+
+Blueprint::Session::Session(const Program &program, std::size_t depth)
+    : _program(program)
+{
+    program.retain();
+    _stream.setDepth(depth);
+    _stream.begin(program);
+}
+
+Blueprint::Session::~Session()
+{
+    if (_program.release()) {
+        delete &_program;
+    }
+}
+
+bool Blueprint::Session::lex(std::string_view data, bool last)
+{
+    _lexer.reset(data);
+
+    while (true) {
+        std::optional<JSON::Token> token = _lexer.nextToken();
+        if (!token.has_value()) {
+            const Error &error = _lexer.getError();
+            std::size_t start = _lexer.start();
+            std::string_view tail = data.substr(start);
+
+            if (!last && error.reason == Reason::UNTERMINATED_STRING) {
+                carry(data, start, Pending::STRING);
+                return true;
+            }
+
+            bool word = tail.find_first_of(DELIMITERS)
+                == std::string_view::npos;
+            if (!last && word && unfinished(tail)) {
+                carry(data, start, Pending::WORD);
+                return true;
+            }
+
+            return reject(data, error);
+        }
+
+        switch (token->type()) {
+            case JSON::Type::END_OF_FILE:
+                consume(data, data.size());
+                return true;
+            case JSON::Type::NUMBER:
+            case JSON::Type::BOOLEAN:
+            case JSON::Type::NULL_VALUE:
+                // The next chunk may continue it
+                if (!last
+                    && token->offset() + token->data().size() == data.size()) {
+                    carry(data, token->offset(), Pending::WORD);
+                    return true;
+                }
+                break;
+            default: break;
+        }
+
+        if (!_stream.step(*token)) {
+            return reject(data, _stream.getError());
+        }
+    }
+}
+
+bool Blueprint::Session::resume(std::string_view &chunk)
+{
+    std::size_t size = std::string_view::npos;
+
+    if (_pending == Pending::STRING) {
+        for (std::size_t i = 0; i < chunk.size(); ++i) {
+            if (_escaped) {
+                _escaped = false;
+                continue;
+            }
+
+            i = chunk.find_first_of("\"\\", i);
+            if (i == std::string_view::npos) {
+                break;
+            }
+
+            if (chunk[i] == '"') {
+                size = i + 1;
+                break;
+            }
+
+            _escaped = true;
+        }
+    } else {
+        size = chunk.find_first_of(DELIMITERS);
+    }
+
+    if (size == std::string_view::npos) {
+        _carry.append(chunk);
+        chunk = {};
+
+        // A word that can no longer become a token fails right away
+        if (_pending == Pending::STRING || unfinished(_carry)) {
+            return true;
+        }
+    } else {
+        _carry.append(chunk.substr(0, size));
+        chunk.remove_prefix(size);
+    }
+
+    return flush();
+}
+
+bool Blueprint::Session::flush()
+{
+    _pending = Pending::NONE;
+    bool valid = lex(_carry, true);
+    _carry.clear();
+
+    return valid;
+}
+
+void Blueprint::Session::carry(
+    std::string_view data, std::size_t start, Pending pending)
+{
+    consume(data, start);
+    _carry.assign(data.substr(start));
+    _pending = pending;
+
+    // An odd run of backslashes escapes the first byte of the next chunk
+    std::size_t text = _carry.find_last_not_of('\\');
+    _escaped =
+        pending == Pending::STRING && (_carry.size() - 1 - text) % 2 == 1;
+}
+
+void Blueprint::Session::consume(std::string_view data, std::size_t size)
+{
+    std::string_view head = data.substr(0, size);
+    std::size_t newline = head.rfind('\n');
+
+    if (newline != std::string_view::npos) {
+        _lines += std::count(head.begin(), head.end(), '\n');
+        _line = _base + newline + 1;
+    }
+
+    _base += size;
+}
+
+bool Blueprint::Session::reject(std::string_view data, const Error &error)
+{
+    _failed = true;
+    _formatted = false;
+    _error = error;
+
+    // Located within the buffer, then moved past everything consumed
+    _error.locate(data);
+    if (_error.line == 1) {
+        _error.column += _base - _line;
+    }
+    if (_error.line != 0) {
+        _error.line += _lines;
+    }
+    if (_error.offset != Error::NO_OFFSET) {
+        _error.offset += _base;
+    }
+
+    return false;
+}
+
+bool Blueprint::Session::feed(std::string_view chunk)
+{
+    if (_failed) {
+        return false;
+    }
+
+    if (_pending != Pending::NONE && !resume(chunk)) {
+        return false;
+    }
+
+    // A token still carried took the whole chunk
+    return _pending != Pending::NONE || lex(chunk, false);
+}
+
+bool Blueprint::Session::end()
+{
+    if (_failed) {
+        return false;
+    }
+
+    if (_pending != Pending::NONE && !flush()) {
+        return false;
+    }
+
+    if (!_stream.step(JSON::Token(JSON::Type::END_OF_FILE, 0, {}))) {
+        return reject({}, _stream.getError());
+    }
+
+    return true;
+}
+
+Blueprint::Verdict Blueprint::Session::getVerdict(bool valid) const
+{
+    return {.valid = static_cast<std::uint8_t>(valid ? 1 : 0),
+        .code = _error.code(),
+        .reason = _error.reason,
+        .reserved = {},
+        .offset = _error.offset,
+        .line = _error.line,
+        .column = _error.column};
+}
+
+const std::string &Blueprint::Session::getMessage() const
+{
+    if (!_formatted) {
+        _message = _failed ? _error.format(&_program) : std::string();
+        _formatted = true;
+    }
+
+    return _message;
+}
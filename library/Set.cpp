@@ -0,0 +1,55 @@
+#include <algorithm>
+#include <string_view>
+#include <vector>
+
+#include "Set.hpp"
+
+void Blueprint::Set::insert(
+    JSON::Kind kind, const JSON::Number &number, std::string_view text)
+{
+    switch (kind) {
+        case JSON::Kind::NUMBER: _numbers.push_back(number); break;
+        case JSON::Kind::STRING: _strings.insert(text); break;
+        case JSON::Kind::BOOLEAN:
+            (text == "true" ? _true : _false) = true;
+            break;
+        case JSON::Kind::NULL_VALUE: _null = true; break;
+        default: break;
+    }
+}
+
+void Blueprint::Set::seal()
+{
+    std::sort(_numbers.begin(), _numbers.end());
+    _numbers.erase(
+        std::unique(_numbers.begin(), _numbers.end()), _numbers.end());
+
+    _strings.seal();
+}
+
+bool Blueprint::Set::contains(JSON::Kind kind, const JSON::Number &number,
+    std::string_view text) const
+{
+    switch (kind) {
+        case JSON::Kind::NUMBER:
+            if (_numbers.size() <= SCAN) {
+                return std::find(_numbers.begin(), _numbers.end(), number)
+                    != _numbers.end();
+            }
+            return std::binary_search(_numbers.begin(), _numbers.end(), number);
+        case JSON::Kind::STRING: return _strings.find(text) != Table::NONE;
+        case JSON::Kind::BOOLEAN: return text == "true" ? _true : _false;
+        case JSON::Kind::NULL_VALUE: return _null;
+        default: return false;
+    }
+}
+
+const Blueprint::Table &Blueprint::Set::strings() const
+{
+    return _strings;
+}
+
+const std::vector<Blueprint::JSON::Number> &Blueprint::Set::numbers() const
+{
+    return _numbers;
+}
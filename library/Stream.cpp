@@ -0,0 +1,330 @@
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+#include "Error.hpp"
+#include "JSON/Lexer.hpp"
+#include "JSON/Token.hpp"
+#include "Program.hpp"
+#include "Stream.hpp"
+#include "Table.hpp"
+
+// Target of a key an open object does not name, its value is only checked
+// for syntax
+static const Blueprint::Program::Node SKIPPED = {};
+
+std::optional<Blueprint::JSON::Token> Blueprint::Stream::next()
+{
+    std::optional<JSON::Token> token = _lexer.nextToken();
+    if (!token.has_value()) {
+        _error = _lexer.getError();
+        return token;
+    }
+
+    if constexpr (STATS) {
+        if (_stats != nullptr) {
+            ++_stats->tokens;
+        }
+    }
+
+    return token;
+}
+
+bool Blueprint::Stream::value(const JSON::Token &token)
+{
+    if (_node == &SKIPPED) {
+        return skip(token);
+    }
+
+    const Program::Node &node = *_node;
+    const Frame *parent = _frames.empty() ? nullptr : &_frames.back();
+    bool member =
+        parent != nullptr && parent->node->kind == Program::Kind::ARRAY;
+    Scalar primitive = {.kind = Program::Kind::NULL_VALUE, .number = {},
+        .text = token.data()};
+
+    switch (token.type()) {
+        case JSON::Type::OBJECT_START:
+        case JSON::Type::ARRAY_START: {
+            Program::Kind kind = token.type() == JSON::Type::OBJECT_START
+                ? Program::Kind::OBJECT
+                : Program::Kind::ARRAY;
+            if (!nest()) {
+                return false;
+            }
+            if (member && !element(*parent->node, kind)) {
+                return trace(_frames.size());
+            }
+            if (!open(node, kind)) {
+                return trace(_frames.size());
+            }
+
+            _frames.push_back({.node = &node, .size = 0, .slot = 0});
+            if constexpr (STATS) {
+                if (_stats != nullptr && _frames.size() > _stats->depth) {
+                    _stats->depth = _frames.size();
+                }
+            }
+            _state = State::FIRST;
+            return true;
+        }
+        case JSON::Type::STRING:
+            primitive.kind = Program::Kind::STRING;
+            break;
+        case JSON::Type::BOOLEAN:
+            primitive.kind = Program::Kind::BOOLEAN;
+            break;
+        case JSON::Type::NULL_VALUE: break;
+        case JSON::Type::NUMBER:
+            primitive.kind = Program::Kind::NUMBER;
+            primitive.number = token.number();
+            break;
+        case JSON::Type::END_OF_FILE:
+            fail(Reason::UNEXPECTED_END);
+            return false;
+        default:
+            fail(Reason::UNEXPECTED_TOKEN).setText(token.data());
+            return false;
+    }
+
+    if (member && !element(*parent->node, primitive)) {
+        return trace(_frames.size());
+    }
+    if (!scalar(node, primitive)) {
+        return trace(_frames.size());
+    }
+
+    after();
+    return true;
+}
+
+bool Blueprint::Stream::skip(const JSON::Token &token)
+{
+    switch (token.type()) {
+        case JSON::Type::OBJECT_START:
+            if (!nest()) {
+                return false;
+            }
+
+            _closers.push_back(JSON::Type::OBJECT_END);
+            _state = State::FIRST;
+            return true;
+        case JSON::Type::ARRAY_START:
+            if (!nest()) {
+                return false;
+            }
+
+            _closers.push_back(JSON::Type::ARRAY_END);
+            _state = State::FIRST;
+            return true;
+        case JSON::Type::STRING:
+        case JSON::Type::NUMBER:
+        case JSON::Type::BOOLEAN:
+        case JSON::Type::NULL_VALUE: after(); return true;
+        case JSON::Type::END_OF_FILE:
+            fail(Reason::UNEXPECTED_END);
+            return false;
+        default:
+            fail(Reason::UNEXPECTED_TOKEN).setText(token.data());
+            return false;
+    }
+}
+
+bool Blueprint::Stream::key(const JSON::Token &token)
+{
+    if (token.type() != JSON::Type::STRING) {
+        fail(Reason::EXPECTED_KEY).setText(token.data());
+        return false;
+    }
+
+    _state = State::COLON;
+    if (!_closers.empty()) {
+        _node = &SKIPPED;
+        return true;
+    }
+
+    Frame &frame = _frames.back();
+    std::size_t slot = frame.node->keys.find(token.data());
+    if (slot == Table::NONE && !frame.node->open) {
+        fail(Reason::UNKNOWN_KEY).setText(token.data());
+        return trace(_frames.size() - 1);
+    }
+
+    frame.slot = slot;
+    _node = slot == Table::NONE ? &SKIPPED
+                                : &(*_program)[frame.node->fields[slot]];
+
+    return true;
+}
+
+bool Blueprint::Stream::member(const JSON::Token &token)
+{
+    if (!_closers.empty()) {
+        if (_closers.back() == JSON::Type::OBJECT_END) {
+            return key(token);
+        }
+
+        _node = &SKIPPED;
+        return skip(token);
+    }
+
+    Frame &frame = _frames.back();
+    ++frame.size;
+
+    if (frame.node->kind != Program::Kind::ARRAY) {
+        return key(token);
+    }
+
+    _node = &(*_program)[frame.node->element];
+    return value(token);
+}
+
+bool Blueprint::Stream::end()
+{
+    if (!_closers.empty()) {
+        _closers.pop_back();
+        after();
+        return true;
+    }
+
+    Frame &frame = _frames.back();
+    if (!close(*frame.node, frame.size)) {
+        return trace(_frames.size() - 1);
+    }
+
+    _frames.pop_back();
+    after();
+    return true;
+}
+
+bool Blueprint::Stream::nest()
+{
+    if (_limit != 0 && _frames.size() + _closers.size() == _limit) {
+        fail(Reason::TOO_DEEP).limit = _limit;
+        return false;
+    }
+
+    return true;
+}
+
+void Blueprint::Stream::after()
+{
+    _state = _frames.empty() && _closers.empty() ? State::DONE : State::NEXT;
+}
+
+bool Blueprint::Stream::trace(std::size_t depth)
+{
+    // Only constraint failures point into the document, a syntax error has
+    // no value to point at
+    if (_error.code() != Code::CONSTRAINT) {
+        return false;
+    }
+
+    for (std::size_t i = depth; i-- > 0;) {
+        const Frame &frame = _frames[i];
+        if (frame.node->kind == Program::Kind::ARRAY) {
+            _error.push({.index = static_cast<std::uint32_t>(frame.size - 1),
+                .node = Segment::ELEMENT});
+        } else {
+            _error.push({.index = static_cast<std::uint32_t>(frame.slot),
+                .node = static_cast<std::uint32_t>(
+                    _program->index(*frame.node))});
+        }
+    }
+
+    _error.reverse();
+
+    return false;
+}
+
+bool Blueprint::Stream::verify(const Program &program, std::string_view data)
+{
+    _lexer.reset(data);
+    begin(program);
+
+    while (true) {
+        std::optional<JSON::Token> token = next();
+        if (!token.has_value() || !step(*token)) {
+            return false;
+        }
+
+        if (token->type() == JSON::Type::END_OF_FILE) {
+            return true;
+        }
+    }
+}
+
+void Blueprint::Stream::begin(const Program &program)
+{
+    _frames.clear();
+    _closers.clear();
+    _error.clear();
+    _offset = NO_OFFSET;
+    _program = &program;
+    _node = &program.root();
+    _state = State::VALUE;
+}
+
+bool Blueprint::Stream::step(const JSON::Token &token)
+{
+    _offset = token.offset();
+
+    switch (_state) {
+        case State::VALUE: return value(token);
+        case State::FIRST:
+        case State::NEXT: {
+            JSON::Type closer = !_closers.empty() ? _closers.back()
+                : _frames.back().node->kind == Program::Kind::ARRAY
+                ? JSON::Type::ARRAY_END
+                : JSON::Type::OBJECT_END;
+            if (token.type() == closer) {
+                return end();
+            }
+
+            if (_state == State::FIRST) {
+                return member(token);
+            }
+
+            if (token.type() != JSON::Type::COMMA) {
+                Error &error = fail(Reason::EXPECTED_SEPARATOR);
+                error.expected = closer == JSON::Type::OBJECT_END
+                    ? Program::Kind::OBJECT
+                    : Program::Kind::ARRAY;
+                error.setText(token.data());
+                return false;
+            }
+
+            _state = State::MEMBER;
+            return true;
+        }
+        case State::MEMBER: return member(token);
+        case State::COLON:
+            if (token.type() != JSON::Type::COLON) {
+                fail(Reason::EXPECTED_COLON).setText(token.data());
+                return false;
+            }
+
+            _state = State::VALUE;
+            return true;
+        case State::DONE:
+            if (token.type() != JSON::Type::END_OF_FILE) {
+                fail(Reason::TRAILING_DATA).setText(token.data());
+                return false;
+            }
+
+            return true;
+    }
+
+    return false;
+}
+
+void Blueprint::Stream::setDepth(std::size_t depth)
+{
+    _limit = depth;
+}
+
+void Blueprint::Stream::setStats(Stats *stats)
+{
+    _stats = stats;
+    _lexer.setStats(stats);
+}
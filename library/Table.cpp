@@ -0,0 +1,174 @@
+#include <cstring>
+#include <string>
+#include <string_view>
+
+#include "Table.hpp"
+
+static constexpr std::uint64_t GOLDEN = 0x9E3779B97F4A7C15ULL;
+static constexpr std::uint64_t MIXER = 0xBF58476D1CE4E5B9ULL;
+// Tables up to this size get sparse slots, where a seed without collisions
+// is likely to exist
+static constexpr std::size_t SMALL = 32;
+
+Blueprint::Table::Key Blueprint::Table::split(std::string_view name)
+{
+    Key key = {.first = 0, .last = 0, .offset = 0,
+        .size = static_cast<std::uint32_t>(name.size()), .index = EMPTY};
+
+    if (name.size() >= 8) {
+        std::memcpy(&key.first, name.data(), 8);
+        std::memcpy(&key.last, name.data() + name.size() - 8, 8);
+    } else if (!name.empty()) {
+        std::memcpy(&key.first, name.data(), name.size());
+    }
+
+    return key;
+}
+
+std::uint64_t Blueprint::Table::hash(
+    const Key &key, std::string_view name, std::uint64_t seed)
+{
+    std::uint64_t hash = (key.first ^ seed) * GOLDEN;
+
+    for (std::size_t i = 8; i + 8 < name.size(); i += 8) {
+        std::uint64_t word;
+        std::memcpy(&word, name.data() + i, 8);
+        hash = (hash ^ (hash >> 32) ^ word) * GOLDEN;
+    }
+
+    // Fold high bits down before every multiply, keys often differ only
+    // in their last byte, which lands in the top bits of the word
+    hash ^= key.last ^ key.size;
+    hash = (hash ^ (hash >> 33)) * MIXER;
+    hash = (hash ^ (hash >> 33)) * GOLDEN;
+
+    return hash ^ (hash >> 33);
+}
+
+bool Blueprint::Table::matches(
+    const Key &key, const Key &probe, std::string_view name) const
+{
+    if (key.first != probe.first || key.last != probe.last
+        || key.size != probe.size) {
+        return false;
+    }
+
+    return name.size() <= 16
+        || std::memcmp(_bytes.data() + key.offset + 8, name.data() + 8,
+               name.size() - 16)
+        == 0;
+}
+
+bool Blueprint::Table::place(std::uint64_t seed, bool probe)
+{
+    Key empty = split({});
+    std::fill(_slots.begin(), _slots.end(), empty);
+
+    for (const Key &key : _keys) {
+        std::string_view name(_bytes.data() + key.offset, key.size);
+        std::size_t slot = hash(key, name, seed) & _mask;
+        bool repeated = false;
+
+        while (_slots[slot].index != EMPTY) {
+            if (!probe) {
+                return false;
+            }
+            if (matches(_slots[slot], key, name)) {
+                repeated = true;
+                break;
+            }
+            slot = (slot + 1) & _mask;
+        }
+
+        if (!repeated) {
+            _slots[slot] = key;
+        }
+    }
+
+    _seed = seed;
+
+    return true;
+}
+
+std::size_t Blueprint::Table::insert(std::string_view name)
+{
+    Key key = split(name);
+    key.offset = static_cast<std::uint32_t>(_bytes.size());
+    key.index = static_cast<std::uint32_t>(_keys.size());
+
+    _bytes.append(name);
+    _keys.push_back(key);
+
+    return key.index;
+}
+
+void Blueprint::Table::seal()
+{
+    if (_keys.size() <= LINEAR) {
+        return;
+    }
+
+    std::size_t size =
+        _keys.size() <= SMALL ? _keys.size() * 8 : _keys.size() * 2;
+    std::size_t capacity = 2;
+    while (capacity < size) {
+        capacity *= 2;
+    }
+
+    _slots.resize(capacity);
+    _mask = capacity - 1;
+
+    if (_keys.size() <= SMALL) {
+        for (std::size_t seed = 1; seed <= SEEDS; ++seed) {
+            if (place(seed * GOLDEN, false)) {
+                _perfect = true;
+                return;
+            }
+        }
+    }
+
+    place(GOLDEN, true);
+}
+
+std::size_t Blueprint::Table::find(std::string_view name) const
+{
+    Key probe = split(name);
+
+    if (_slots.empty()) {
+        for (const Key &key : _keys) {
+            if (matches(key, probe, name)) {
+                return key.index;
+            }
+        }
+
+        return NONE;
+    }
+
+    std::size_t slot = hash(probe, name, _seed) & _mask;
+    for (;; slot = (slot + 1) & _mask) {
+        const Key &key = _slots[slot];
+        if (key.index == EMPTY) {
+            return NONE;
+        }
+
+        if (matches(key, probe, name)) {
+            return key.index;
+        }
+
+        if (_perfect) {
+            return NONE;
+        }
+    }
+}
+
+std::size_t Blueprint::Table::size() const
+{
+    return _keys.size();
+}
+
+std::string_view Blueprint::Table::name(std::size_t index) const
+{
+    const Key &key = _keys[index];
+
+    return std::string_view(_bytes.data() + key.offset, key.size);
+}
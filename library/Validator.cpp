@@ -0,0 +1,158 @@
+#include <vector>
+
+#include "Program.hpp"
+#include "Set.hpp"
+#include "Validator.hpp"
+
+static bool contains(const Blueprint::Set &set, const Blueprint::Scalar &value)
+{
+    return set.contains(value.kind, value.number, value.text);
+}
+
+bool Blueprint::Validator::run(const Program::Node &node,
+    const std::vector<Program::Instruction> &code, const Scalar &value,
+    std::size_t length)
+{
+    using Opcode = Program::Opcode;
+
+    for (const Program::Instruction &instruction : code) {
+        if constexpr (STATS) {
+            if (_stats != nullptr) {
+                ++_stats->constraints;
+            }
+        }
+
+        switch (instruction.opcode) {
+            case Opcode::MIN_VALUE:
+                if (value.number < instruction.bound) {
+                    Error &error = fail(Reason::MIN_VALUE);
+                    error.value = value.number;
+                    error.bound = instruction.bound;
+                    return false;
+                }
+                break;
+            case Opcode::MAX_VALUE:
+                if (value.number > instruction.bound) {
+                    Error &error = fail(Reason::MAX_VALUE);
+                    error.value = value.number;
+                    error.bound = instruction.bound;
+                    return false;
+                }
+                break;
+            case Opcode::MIN_LENGTH:
+                if (length >= instruction.operand) {
+                    break;
+                }
+                fail(Reason::MIN_LENGTH);
+                _error.expected = node.kind;
+                _error.length = length;
+                _error.limit = instruction.operand;
+                return false;
+            case Opcode::MAX_LENGTH:
+                if (length <= instruction.operand) {
+                    break;
+                }
+                fail(Reason::MAX_LENGTH);
+                _error.expected = node.kind;
+                _error.length = length;
+                _error.limit = instruction.operand;
+                return false;
+            case Opcode::ENUM:
+                if (!contains(node.sets[instruction.operand], value)) {
+                    fail(Reason::ENUM).setText(value.text);
+                    return false;
+                }
+                break;
+            case Opcode::VALUES:
+                if (contains(node.sets[instruction.operand], value)) {
+                    break;
+                }
+                fail(Reason::VALUES);
+                _error.actual = value.kind;
+                _error.value = value.number;
+                _error.setText(value.text);
+                return false;
+            case Opcode::REJECT:
+                fail(Reason::REJECT).actual = value.kind;
+                return false;
+            case Opcode::REQUIRED:
+                fail(Reason::REQUIRED);
+                return false;
+        }
+    }
+
+    return true;
+}
+
+bool Blueprint::Validator::scalar(
+    const Program::Node &node, const Scalar &value)
+{
+    if (node.kind != value.kind) {
+        Error &error = fail(Reason::TYPE);
+        error.expected = node.kind;
+        error.actual = value.kind;
+        return false;
+    }
+
+    return run(node, node.checks, value, value.text.size());
+}
+
+bool Blueprint::Validator::element(
+    const Program::Node &node, const Scalar &value)
+{
+    return run(node, node.elements, value, 0);
+}
+
+bool Blueprint::Validator::element(
+    const Program::Node &node, Program::Kind kind)
+{
+    if (!node.elements.empty()) {
+        fail(Reason::SCALAR_ELEMENTS).actual = kind;
+        return false;
+    }
+
+    return true;
+}
+
+bool Blueprint::Validator::open(const Program::Node &node, Program::Kind kind)
+{
+    if (node.kind != kind) {
+        Error &error = fail(Reason::TYPE);
+        error.expected = node.kind;
+        error.actual = kind;
+        return false;
+    }
+
+    Scalar value = {.kind = kind, .number = {}, .text = ""};
+    return run(node, node.checks, value, 0);
+}
+
+bool Blueprint::Validator::close(const Program::Node &node, std::size_t size)
+{
+    Scalar value = {.kind = node.kind, .number = {}, .text = ""};
+    return run(node, node.sizes, value, size);
+}
+
+Blueprint::Error &Blueprint::Validator::fail(Reason reason)
+{
+    _error.clear();
+    _error.reason = reason;
+    _error.offset = _offset;
+
+    return _error;
+}
+
+const Blueprint::Error &Blueprint::Validator::getError() const
+{
+    return _error;
+}
+
+Blueprint::Code Blueprint::Validator::getCode() const
+{
+    return _error.code();
+}
+
+std::size_t Blueprint::Validator::getOffset() const
+{
+    return _error.offset;
+}
@@ -1,6 +1,65 @@
+import { sprintf } from "@std/fmt/printf";
 import { init } from "~/sources/loader.ts";
+import { Packer } from "~/sources/packer.ts";
 import { Constraints, type ISchema } from "~/sources/schema.ts";
-import type { Blueprint, InferSchema, PayloadMap } from "~/sources/types.ts";
+import { toLocation, Upload } from "~/sources/upload.ts";
+import type {
+  Blueprint,
+  Failure,
+  FailureCode,
+  InferSchema,
+  LinesReport,
+  Location,
+  Mode,
+  Outcome,
+  PayloadMap,
+  Stats,
+} from "~/sources/types.ts";
+
+/**
+ * Maps each validation mode to its native identifier.
+ */
+const MODES: Record<Mode, number> = {
+  tree: 0,
+  stream: 1,
+};
+
+/**
+ * Maps each native failure code to its name.
+ */
+const CODES: Record<number, FailureCode> = {
+  1: "syntax",
+  2: "constraint",
+};
+
+/**
+ * Size in bytes of a native failure record.
+ */
+const FAILURE_SIZE = 24;
+
+/**
+ * Index of the deepest nesting among the native counters, which is kept
+ * as a maximum rather than summed.
+ */
+const DEPTH = 5;
+
+/**
+ * Deepest nesting a native handle accepts until told otherwise.
+ */
+const MAX_DEPTH = 1024;
+
+/**
+ * Native handle running one asynchronous verification at a time. A handle
+ * is only ever used by one thread, so every call in flight has its own.
+ */
+type Lane = {
+  pointer: Deno.PointerObject<unknown>;
+  verdict: BigUint64Array;
+  mode: Mode;
+  depth: number;
+  // Whether its counters were cleared while it was busy
+  stale: boolean;
+};
 
 /**
  * Represents the base blueprint class.
@@ -27,9 +86,28 @@ import type { Blueprint, InferSchema, PayloadMap } from "~/sources/types.ts";
  * @extends Constraints
  */
 export class b extends Constraints {
-  private _error: string | null = null;
+  // `undefined` until the message of a failed call is first read
+  private _error: string | null | undefined = null;
+  private _location: Location | null = null;
+  private _encoder = new TextEncoder();
+  private _buffer = new Uint8Array(1024);
+  private _packer = new Packer();
+  private _verdict = new BigUint64Array(4);
+  private _results = new Uint8Array(0);
+  private _errors: (string | null)[] | undefined = [];
+  private _mode: Mode = "tree";
+  private _depth = MAX_DEPTH;
+  private _threads = 0;
   private _handle: Blueprint & Disposable;
   private _blueprint: Deno.PointerObject<unknown>;
+  private _schemas = new Set<ISchema<keyof PayloadMap>>();
+  // Every lane, the idle ones, the callers waiting for one and the count
+  // of calls in flight and open uploads
+  private _lanes: Lane[] = [];
+  private _idle: Lane[] = [];
+  private _waiting: ((lane: Lane) => void)[] = [];
+  private _pending = 0;
+  private _disposed = false;
 
   private constructor(handle: Blueprint & Disposable) {
     super();
@@ -55,6 +133,8 @@ export class b extends Constraints {
 
   /**
    * Verifies the given data using the specified schema.
+   * The schema is compiled on its first verification and the compiled
+   * program is reused by every later call.
    * @param schema - The schema to use for parsing.
    * @param data - The data to verify.
    * @returns A boolean indicating whether the parsing was successful.
@@ -63,34 +143,520 @@ export class b extends Constraints {
     schema: T,
     data: InferSchema<T>,
   ): boolean {
-    const valid = this._handle.verify(
+    const bytes = this.encode(JSON.stringify(data));
+    const valid = this._handle.verify_v2(
       this._blueprint,
-      schema.toPointer(),
-      this.toPointer(JSON.stringify(data)),
+      this.compile(schema),
+      bytes,
+      bytes.length,
+      this._verdict,
     );
-    this._error = null;
+    this.readVerdict(valid);
 
-    if (!valid) {
-      const error = this._handle.error(this._blueprint);
-      if (error === null) {
-        throw new Error("Failed to get error message");
+    return valid;
+  }
+
+  /**
+   * Verifies the given data like `verify`, without blocking the event loop.
+   * The validation runs on a native thread, so many calls can be in flight
+   * at once. Up to `threads` calls run at the same time, one per core when
+   * it is `0`, and the rest wait for a free one. The outcome is returned
+   * rather than kept on the handle, so its message is formatted as soon as
+   * a call fails.
+   * @param schema - The schema to use for parsing.
+   * @param data - The data to verify.
+   * @returns A promise of the outcome of the verification.
+   */
+  async verifyAsync<T extends ISchema<keyof PayloadMap>>(
+    schema: T,
+    data: InferSchema<T>,
+  ): Promise<Outcome> {
+    if (this._disposed) {
+      throw new Error("Blueprint has been disposed");
+    }
+
+    // The bytes and a reference to the program must outlive the call
+    const program = this.compile(schema);
+    const bytes = this._encoder.encode(JSON.stringify(data));
+    this._handle.retain(program);
+    this._pending++;
+
+    let lane: Lane | undefined;
+    try {
+      lane = await this.acquire();
+      const valid = await this._handle.verify_async(
+        lane.pointer,
+        program,
+        bytes,
+        bytes.length,
+        lane.verdict,
+      );
+
+      return {
+        valid,
+        error: valid ? null : this.readError(lane.pointer),
+        location: valid ? null : toLocation(lane.verdict),
+      };
+    } finally {
+      if (lane !== undefined) {
+        this.vacate(lane);
       }
+      this._handle.release(program);
+      if (--this._pending === 0 && this._disposed) {
+        this.close();
+      }
+    }
+  }
+
+  /**
+   * Verifies the given data like `verify`, but sends it as MessagePack
+   * instead of JSON text. The data is packed straight into bytes without
+   * building a string, and the native side reads it without lexing. Packed
+   * data is always validated as a tree, whatever the mode.
+   * @param schema - The schema to use for parsing.
+   * @param data - The data to verify.
+   * @returns A boolean indicating whether the data is valid.
+   */
+  verifyPacked<T extends ISchema<keyof PayloadMap>>(
+    schema: T,
+    data: InferSchema<T>,
+  ): boolean {
+    return this.verifyPackedBytes(schema, this._packer.pack(data));
+  }
 
-      const view = new Deno.UnsafePointerView(error);
-      this._error = view.getCString();
+  /**
+   * Verifies a document already encoded as MessagePack, such as a request
+   * body from another service. Strings are read as plain UTF-8, the way any
+   * MessagePack encoder writes them.
+   * @param schema - The schema to use for parsing.
+   * @param bytes - The MessagePack bytes of the document.
+   * @returns A boolean indicating whether the data is valid.
+   */
+  verifyPackedBytes<T extends ISchema<keyof PayloadMap>>(
+    schema: T,
+    bytes: Uint8Array,
+  ): boolean {
+    const valid = this._handle.verify_packed(
+      this._blueprint,
+      this.compile(schema),
+      bytes,
+      bytes.length,
+      this._verdict,
+    );
+    this.readVerdict(valid);
+
+    return valid;
+  }
+
+  /**
+   * Starts verifying a document received in chunks, such as a request
+   * body. Each chunk is validated as it is fed, so an invalid document is
+   * rejected by the chunk holding the offending byte. Chunked documents are
+   * always validated as a stream, whatever the mode. The upload must be
+   * disposed once done with.
+   * @param schema - The schema to use for parsing.
+   * @returns The upload the chunks are fed to.
+   */
+  begin<T extends ISchema<keyof PayloadMap>>(schema: T): Upload {
+    if (this._disposed) {
+      throw new Error("Blueprint has been disposed");
     }
 
+    // The session holds its own reference to the program
+    const session = this._handle.verify_begin(
+      this._blueprint,
+      this.compile(schema),
+    );
+    if (session === null) {
+      throw new Error("Failed to start verification");
+    }
+
+    this._pending++;
+
+    return new Upload(this._handle, session, () => {
+      if (--this._pending === 0 && this._disposed) {
+        this.close();
+      }
+    });
+  }
+
+  /**
+   * Verifies a document read chunk by chunk, such as the body of a request.
+   * Reading stops at the first invalid chunk, which cancels a stream.
+   * @param schema - The schema to use for parsing.
+   * @param chunks - The chunks of the serialized document, in order.
+   * @returns A promise of the outcome of the verification.
+   */
+  async verifyStream<T extends ISchema<keyof PayloadMap>>(
+    schema: T,
+    chunks: AsyncIterable<Uint8Array>,
+  ): Promise<Outcome> {
+    using upload = this.begin(schema);
+    for await (const chunk of chunks) {
+      if (!upload.feed(chunk)) {
+        break;
+      }
+    }
+
+    return upload.end();
+  }
+
+  /**
+   * Verifies many items against the same schema in a single native call.
+   * The payloads are packed into one contiguous buffer, and the error of
+   * every failed item is available through `errors` afterwards. Messages
+   * are only formatted when `errors` is read.
+   * @param schema - The schema to use for parsing.
+   * @param items - The items to verify.
+   * @returns Whether each item is valid, in input order.
+   */
+  verifyMany<T extends ISchema<keyof PayloadMap>>(
+    schema: T,
+    items: InferSchema<T>[],
+  ): boolean[] {
+    const program = this.compile(schema);
+    const encoder = new TextEncoder();
+    const payloads = items.map((item) => encoder.encode(JSON.stringify(item)));
+    const size = payloads.reduce((total, payload) => total + payload.length, 0);
+
+    const buffer = new Uint8Array(Math.max(size, 1));
+    const base = Deno.UnsafePointer.of(buffer);
+    if (base === null) {
+      throw new Error("Failed to create pointer");
+    }
+
+    const documents = new BigUint64Array(items.length);
+    const lengths = new BigUint64Array(items.length);
+    let offset = 0;
+    payloads.forEach((payload, i) => {
+      buffer.set(payload, offset);
+      documents[i] = BigInt(
+        Deno.UnsafePointer.value(Deno.UnsafePointer.offset(base, offset)),
+      );
+      lengths[i] = BigInt(payload.length);
+      offset += payload.length;
+    });
+
+    const results = new Uint8Array(items.length);
+    const valid = this._handle.verify_batch(
+      this._blueprint,
+      program,
+      documents,
+      lengths,
+      items.length,
+      results,
+    );
+    this.settle(valid);
+    this._results = results;
+    this._errors = undefined;
+
+    return Array.from(results, (result) => result === 1);
+  }
+
+  /**
+   * Verifies every record of a newline-delimited JSON buffer against the
+   * same schema in a single native call. Blank lines are skipped.
+   * @param schema - The schema to use for parsing.
+   * @param data - The NDJSON text or its UTF-8 bytes.
+   * @returns The record count, a validity bitmap and the failed records.
+   */
+  verifyLines<T extends ISchema<keyof PayloadMap>>(
+    schema: T,
+    data: string | Uint8Array,
+  ): LinesReport {
+    const program = this.compile(schema);
+    const bytes = typeof data === "string"
+      ? new TextEncoder().encode(data)
+      : data;
+
+    const report = new BigUint64Array(4);
+    const valid = this._handle.verify_lines(
+      this._blueprint,
+      program,
+      bytes,
+      bytes.length,
+      report,
+    );
+    this.settle(valid);
+
+    const records = Number(report[0]);
+    const failed = Number(report[1]);
+    const bitmap = Deno.UnsafePointer.create(report[2]);
+    const failures: Failure[] = [];
+
+    if (failed !== 0) {
+      const pointer = Deno.UnsafePointer.create(report[3]);
+      if (pointer === null) {
+        throw new Error("Failed to read failed records");
+      }
+
+      const view = new Deno.UnsafePointerView(pointer);
+      for (let i = 0; i < failed; i++) {
+        const offset = i * FAILURE_SIZE;
+        failures.push({
+          record: Number(view.getBigUint64(offset)),
+          offset: Number(view.getBigUint64(offset + 8)),
+          code: CODES[view.getUint8(offset + 16)],
+        });
+      }
+    }
+
+    const size = Math.ceil(records / 8);
+    const copy = new Uint8Array(size);
+    if (bitmap !== null && size !== 0) {
+      copy.set(
+        new Uint8Array(Deno.UnsafePointerView.getArrayBuffer(bitmap, size)),
+      );
+    }
+
+    return { records, valid: copy, failures };
+  }
+
+  /**
+   * Verifies a JSON file against the specified schema. The file is mapped
+   * into memory and validated in place as a stream, whatever the mode, so
+   * it is never loaded into a string nor built into a document. Memory use
+   * stays flat beyond the pages of the file cached by the kernel.
+   * @param schema - The schema to use for parsing.
+   * @param path - The path of the file to verify.
+   * @returns A boolean indicating whether the file is valid.
+   */
+  verifyFile<T extends ISchema<keyof PayloadMap>>(
+    schema: T,
+    path: string,
+  ): boolean {
+    const valid = this._handle.verify_file(
+      this._blueprint,
+      this.compile(schema),
+      this.toPointer(path),
+    );
+    this.settle(valid);
+
     return valid;
   }
 
+  /**
+   * Loads a validator generated ahead of time for the schema, by running
+   * `blueprint_codegen` on `schema.toString()` and building the output as
+   * a plugin library. Every later call on the schema tries it first, and
+   * documents it turns down are checked again the usual way, so failures
+   * read the same.
+   * @param schema - The schema the plugin was generated from.
+   * @param path - The path of the plugin library.
+   * @throws Error if the library cannot be loaded or was generated from
+   * another schema.
+   */
+  plugin<T extends ISchema<keyof PayloadMap>>(schema: T, path: string) {
+    const bytes = schema.toBytes();
+    const program = this._handle.compile_plugin(
+      this._blueprint,
+      this.toPointer(path),
+      bytes,
+      bytes.length,
+    );
+    if (program === null) {
+      throw new Error(sprintf("Failed to load plugin: %s", this.lastError()));
+    }
+
+    const previous = schema.detach(this);
+    if (previous !== undefined) {
+      this._handle.release(previous);
+    }
+    schema.attach(this, program);
+    this._schemas.add(schema);
+  }
+
+  /**
+   * Clears the performance counters read through `stats`.
+   */
+  resetStats() {
+    this._handle.reset_stats(this._blueprint);
+    // A busy lane is cleared once its call finishes
+    for (const lane of this._lanes) {
+      if (this._idle.includes(lane)) {
+        this._handle.reset_stats(lane.pointer);
+      } else {
+        lane.stale = true;
+      }
+    }
+  }
+
   /**
    * Disposes the blueprint and releases any resources.
    */
   [Symbol.dispose]() {
+    for (const schema of this._schemas) {
+      const program = schema.detach(this);
+      if (program !== undefined) {
+        this._handle.release(program);
+      }
+    }
+    this._schemas.clear();
+
     this._handle.destroy(this._blueprint);
+    this._disposed = true;
+
+    // Calls in flight and open uploads hold their programs, the library is
+    // closed after them
+    if (this._pending === 0) {
+      this.close();
+    }
+  }
+
+  private close() {
+    for (const lane of this._lanes) {
+      this._handle.destroy(lane.pointer);
+    }
+    this._lanes = [];
+    this._idle = [];
     this._handle[Symbol.dispose]();
   }
 
+  /**
+   * Takes an idle lane, creating one while under the thread count, or
+   * waits for a call in flight to finish.
+   * @returns A lane set to the current mode and depth.
+   */
+  private acquire(): Promise<Lane> | Lane {
+    let lane = this._idle.pop();
+    const limit = this._threads || navigator.hardwareConcurrency;
+    if (lane === undefined && this._lanes.length < limit) {
+      const pointer = this._handle.create();
+      if (pointer === null) {
+        throw new Error("Failed to create blueprint");
+      }
+
+      lane = {
+        pointer,
+        verdict: new BigUint64Array(4),
+        mode: "tree",
+        depth: MAX_DEPTH,
+        stale: false,
+      };
+      this._lanes.push(lane);
+    }
+
+    if (lane === undefined) {
+      return new Promise((resolve) => this._waiting.push(resolve));
+    }
+
+    this.sync(lane);
+
+    return lane;
+  }
+
+  /**
+   * Hands a lane to the next waiting call, or returns it to the idle ones.
+   * @param lane - The lane whose call finished.
+   */
+  private vacate(lane: Lane) {
+    if (lane.stale) {
+      this._handle.reset_stats(lane.pointer);
+      lane.stale = false;
+    }
+
+    const next = this._waiting.shift();
+    if (next === undefined) {
+      this._idle.push(lane);
+      return;
+    }
+
+    this.sync(lane);
+    next(lane);
+  }
+
+  /**
+   * Applies the current mode and depth to a lane.
+   * @param lane - The lane about to run a call.
+   */
+  private sync(lane: Lane) {
+    if (lane.mode !== this._mode) {
+      this._handle.set_mode(lane.pointer, MODES[this._mode]);
+      lane.mode = this._mode;
+    }
+    if (lane.depth !== this._depth) {
+      this._handle.set_depth(lane.pointer, this._depth);
+      lane.depth = this._depth;
+    }
+  }
+
+  private compile<T extends ISchema<keyof PayloadMap>>(
+    schema: T,
+  ): Deno.PointerObject<unknown> {
+    const program = schema.compile(
+      this,
+      (bytes) => this._handle.compile_v2(this._blueprint, bytes, bytes.length),
+    );
+    if (program === null) {
+      throw new Error(sprintf("Failed to compile schema: %s", this.lastError()));
+    }
+    this._schemas.add(schema);
+
+    return program;
+  }
+
+  /**
+   * Encodes the data into the reusable buffer, growing it when needed.
+   * @param data - The text to encode.
+   * @returns A view of the encoded bytes.
+   */
+  private encode(data: string): Uint8Array {
+    let { read, written } = this._encoder.encodeInto(data, this._buffer);
+    if (read < data.length) {
+      this._buffer = new Uint8Array(data.length * 3);
+      ({ written } = this._encoder.encodeInto(data, this._buffer));
+    }
+
+    return this._buffer.subarray(0, written);
+  }
+
+  /**
+   * Resets the outcome of the last call, its message is read on demand.
+   * @param valid - Whether the last call passed.
+   */
+  private settle(valid: boolean) {
+    this._error = valid ? null : undefined;
+    this._location = null;
+    this._errors = [];
+  }
+
+  /**
+   * Reads the location of the failure from the verdict of the last call.
+   * @param valid - Whether the last call passed.
+   */
+  private readVerdict(valid: boolean) {
+    this.settle(valid);
+    if (!valid) {
+      this._location = toLocation(this._verdict);
+    }
+  }
+
+  private lastError(): string {
+    return this.readError(this._blueprint);
+  }
+
+  private readError(pointer: Deno.PointerObject<unknown>): string {
+    const error = this._handle.error(pointer);
+    if (error === null) {
+      throw new Error("Failed to get error message");
+    }
+
+    const view = new Deno.UnsafePointerView(error);
+
+    return view.getCString();
+  }
+
+  private batchError(index: number): string {
+    const error = this._handle.batch_error(this._blueprint, index);
+    if (error === null) {
+      throw new Error("Failed to get error message");
+    }
+
+    const view = new Deno.UnsafePointerView(error);
+
+    return view.getCString();
+  }
+
   private toPointer(data: string) {
     const bytes = new TextEncoder().encode(data + "\0");
     const pointer = Deno.UnsafePointer.of(bytes);
@@ -102,10 +668,166 @@ export class b extends Constraints {
   }
 
   /**
-   * Gets the error message if the last operation failed
+   * Gets the validation mode of the blueprint.
+   * @returns The current validation mode.
+   */
+  public get mode(): Mode {
+    return this._mode;
+  }
+
+  /**
+   * Sets the validation mode of the blueprint. In `stream` mode the data is
+   * validated as it is tokenized, stopping at the first violation.
+   * @param value - The validation mode to use.
+   */
+  public set mode(value: Mode) {
+    this._handle.set_mode(this._blueprint, MODES[value]);
+    this._mode = value;
+  }
+
+  /**
+   * Gets the deepest nesting of arrays and objects a document may have.
+   * @returns The depth limit, `0` meaning no limit.
+   */
+  public get depth(): number {
+    return this._depth;
+  }
+
+  /**
+   * Sets the deepest nesting of arrays and objects a document may have. A
+   * deeper document is rejected while it is read, before any of it is
+   * validated against the schema. Schemas compiled afterwards are held to
+   * the same limit.
+   * @param value - The depth limit, `0` for no limit.
+   */
+  public set depth(value: number) {
+    if (!Number.isInteger(value) || value < 0 || value > 0xffffffff) {
+      throw new Error(sprintf("Invalid depth %s", value));
+    }
+
+    this._handle.set_depth(this._blueprint, value);
+    this._depth = value;
+  }
+
+  /**
+   * Gets the worker count used by `verifyMany` and `verifyLines`, and the
+   * number of `verifyAsync` calls run at the same time.
+   * @returns The worker count, `0` meaning one per core.
+   */
+  public get threads(): number {
+    return this._threads;
+  }
+
+  /**
+   * Sets the worker count used by `verifyMany` and `verifyLines`, and the
+   * number of `verifyAsync` calls run at the same time. The workers are
+   * spawned on the first large enough call and results are always returned
+   * in input order. Natively at most eight workers per core are spawned.
+   * @param value - The worker count, `0` for one per core.
+   */
+  public set threads(value: number) {
+    if (!Number.isInteger(value) || value < 0 || value > 0xffffffff) {
+      throw new Error(sprintf("Invalid thread count %s", value));
+    }
+
+    this._handle.set_threads(this._blueprint, value);
+    this._threads = value;
+  }
+
+  /**
+   * Gets the error message if the last operation failed. The message names
+   * the failing value by its JSON Pointer and is formatted on first read.
    * @returns The error message if the last operation failed, otherwise `null`.
    */
   public get error(): string | null {
+    if (this._error === undefined) {
+      this._error = this.lastError();
+    }
+
     return this._error;
   }
+
+  /**
+   * Gets the byte offset in the serialized input where the last `verify`
+   * call failed.
+   * @returns The offset, or `null` if it passed or the failure has no
+   * position in the input.
+   */
+  public get offset(): number | null {
+    return this._location?.offset ?? null;
+  }
+
+  /**
+   * Gets the offset, line and column in the serialized input where the
+   * last `verify` call failed.
+   * @returns The location, or `null` if it passed or the failure has no
+   * position in the input.
+   */
+  public get location(): Location | null {
+    return this._location;
+  }
+
+  /**
+   * Gets the performance counters of every validation since the handle was
+   * created or `resetStats` was called.
+   * @returns The counters, or `null` if the native library was built
+   * without `BLUEPRINT_STATS`.
+   */
+  public get stats(): Stats | null {
+    const counters = new BigUint64Array(9);
+    if (!this._handle.stats(this._blueprint, counters)) {
+      return null;
+    }
+
+    // Counters of lanes in flight are still being written, they are added
+    // once their call finishes
+    const lane = new BigUint64Array(9);
+    for (const { pointer } of this._idle) {
+      this._handle.stats(pointer, lane);
+      lane.forEach((value, i) => {
+        counters[i] = i === DEPTH
+          ? (value > counters[i] ? value : counters[i])
+          : counters[i] + value;
+      });
+    }
+
+    const [
+      verifications,
+      bytes,
+      tokens,
+      nodes,
+      constraints,
+      depth,
+      lex,
+      parse,
+      validate,
+    ] = Array.from(counters, Number);
+
+    return {
+      verifications,
+      bytes,
+      tokens,
+      nodes,
+      constraints,
+      depth,
+      lex,
+      parse,
+      validate,
+    };
+  }
+
+  /**
+   * Gets the error of every item of the last `verifyMany` call.
+   * @returns The error message of each failed item, `null` for valid ones.
+   */
+  public get errors(): (string | null)[] {
+    if (this._errors === undefined) {
+      this._errors = Array.from(
+        this._results,
+        (result, i) => result === 1 ? null : this.batchError(i),
+      );
+    }
+
+    return this._errors;
+  }
 }
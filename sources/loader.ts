@@ -84,6 +84,61 @@ async function init(): Promise<Blueprint & Disposable> {
     destroy: { parameters: ["pointer"], result: "void" },
     verify: { parameters: ["pointer", "pointer", "pointer"], result: "bool" },
     error: { parameters: ["pointer"], result: "pointer" },
+    compile: { parameters: ["pointer", "pointer"], result: "pointer" },
+    verify_compiled: {
+      parameters: ["pointer", "pointer", "pointer"],
+      result: "bool",
+    },
+    compile_v2: {
+      parameters: ["pointer", "buffer", "usize"],
+      result: "pointer",
+    },
+    compile_plugin: {
+      parameters: ["pointer", "pointer", "buffer", "usize"],
+      result: "pointer",
+    },
+    verify_v2: {
+      parameters: ["pointer", "pointer", "buffer", "usize", "buffer"],
+      result: "bool",
+    },
+    verify_async: {
+      name: "verify_v2",
+      parameters: ["pointer", "pointer", "buffer", "usize", "buffer"],
+      result: "bool",
+      nonblocking: true,
+    },
+    verify_packed: {
+      parameters: ["pointer", "pointer", "buffer", "usize", "buffer"],
+      result: "bool",
+    },
+    verify_begin: { parameters: ["pointer", "pointer"], result: "pointer" },
+    verify_feed: {
+      parameters: ["pointer", "buffer", "usize", "buffer"],
+      result: "bool",
+    },
+    verify_end: { parameters: ["pointer", "buffer"], result: "bool" },
+    session_error: { parameters: ["pointer"], result: "pointer" },
+    session_destroy: { parameters: ["pointer"], result: "void" },
+    retain: { parameters: ["pointer"], result: "pointer" },
+    release: { parameters: ["pointer"], result: "void" },
+    set_mode: { parameters: ["pointer", "u8"], result: "void" },
+    set_depth: { parameters: ["pointer", "u32"], result: "void" },
+    set_threads: { parameters: ["pointer", "u32"], result: "void" },
+    verify_batch: {
+      parameters: ["pointer", "pointer", "buffer", "buffer", "usize", "buffer"],
+      result: "bool",
+    },
+    batch_error: { parameters: ["pointer", "usize"], result: "pointer" },
+    verify_file: {
+      parameters: ["pointer", "pointer", "pointer"],
+      result: "bool",
+    },
+    verify_lines: {
+      parameters: ["pointer", "pointer", "buffer", "usize", "buffer"],
+      result: "bool",
+    },
+    stats: { parameters: ["pointer", "buffer"], result: "bool" },
+    reset_stats: { parameters: ["pointer"], result: "void" },
   });
 
   const versionPointer = handle.symbols.version();
@@ -1,2 +1,12 @@
 export { b } from "~/sources/blueprint.ts";
-export type { InferSchema } from "~/sources/types.ts";
+export type { Upload } from "~/sources/upload.ts";
+export type {
+  Failure,
+  FailureCode,
+  InferSchema,
+  LinesReport,
+  Location,
+  Mode,
+  Outcome,
+  Stats,
+} from "~/sources/types.ts";
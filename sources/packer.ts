@@ -0,0 +1,223 @@
+/**
+ * Range of the MessagePack int64 type.
+ */
+const MIN_INT64 = -(2n ** 63n);
+const MAX_INT64 = 2n ** 63n - 1n;
+
+/**
+ * Encodes values as MessagePack into a buffer reused across calls. Values
+ * are packed the way `JSON.stringify` would print them: `toJSON` is called,
+ * non-finite numbers become `null`, and `undefined`, functions and symbols
+ * are dropped from objects and turned into `null` inside arrays. Strings
+ * are plain UTF-8 as in any MessagePack, the native side escapes them into
+ * their JSON form itself. Lone surrogates, which UTF-8 cannot hold, arrive
+ * as U+FFFD.
+ */
+export class Packer {
+  private _buffer = new Uint8Array(1024);
+  private _view = new DataView(this._buffer.buffer);
+  private _length = 0;
+  private _encoder = new TextEncoder();
+
+  /**
+   * Packs a value, the result is only valid until the next call.
+   * @param value - The value to pack.
+   * @returns The MessagePack bytes of the value.
+   */
+  public pack(value: unknown): Uint8Array {
+    this._length = 0;
+    if (!this.value(value, "")) {
+      throw new Error(`Cannot pack ${String(value)}`);
+    }
+
+    return this._buffer.subarray(0, this._length);
+  }
+
+  private value(value: unknown, key: string): boolean {
+    if (
+      typeof value === "object" && value !== null &&
+      typeof (value as { toJSON?: unknown }).toJSON === "function"
+    ) {
+      value = (value as { toJSON: (key: string) => unknown }).toJSON(key);
+    }
+
+    switch (typeof value) {
+      case "number":
+        this.number(value);
+        return true;
+      case "string":
+        this.string(value);
+        return true;
+      case "boolean":
+        this.byte(value ? 0xc3 : 0xc2);
+        return true;
+      case "bigint":
+        throw new TypeError("Do not know how to pack a BigInt");
+      case "object":
+        if (value === null) {
+          this.byte(0xc0);
+        } else if (Array.isArray(value)) {
+          this.array(value);
+        } else {
+          this.object(value as Record<string, unknown>);
+        }
+        return true;
+      default:
+        return false;
+    }
+  }
+
+  private number(value: number): void {
+    if (!Number.isFinite(value)) {
+      this.byte(0xc0);
+    } else if (!Number.isSafeInteger(value)) {
+      // JSON prints large integers by their shortest digits, which the
+      // native side reads back exactly while they fit in an int64
+      const digits = Number.isInteger(value) && Math.abs(value) < 2 ** 63
+        ? BigInt(String(value))
+        : null;
+      this.reserve(9);
+      if (digits !== null && digits >= MIN_INT64 && digits <= MAX_INT64) {
+        this._buffer[this._length] = 0xd3;
+        this._view.setBigInt64(this._length + 1, digits);
+      } else {
+        this._buffer[this._length] = 0xcb;
+        this._view.setFloat64(this._length + 1, value);
+      }
+      this._length += 9;
+    } else if (value >= 0 && value < 0x80) {
+      this.byte(value);
+    } else if (value < 0 && value >= -0x20) {
+      this.byte(value & 0xff);
+    } else if (value >= -0x80000000 && value < 0x100000000) {
+      this.reserve(5);
+      if (value >= 0) {
+        this._buffer[this._length] = 0xce;
+        this._view.setUint32(this._length + 1, value);
+      } else {
+        this._buffer[this._length] = 0xd2;
+        this._view.setInt32(this._length + 1, value);
+      }
+      this._length += 5;
+    } else {
+      this.reserve(9);
+      this._buffer[this._length] = 0xd3;
+      this._view.setBigInt64(this._length + 1, BigInt(value));
+      this._length += 9;
+    }
+  }
+
+  private string(value: string): void {
+    // Every UTF-16 unit takes at most three bytes, the header is sized for
+    // that and moved back when the text turns out shorter
+    const bound = value.length * 3;
+    const header = bound < 0x20 ? 1 : bound <= 0xffff ? 3 : 5;
+    this.reserve(header + bound);
+    const { written } = this._encoder.encodeInto(
+      value,
+      this._buffer.subarray(this._length + header),
+    );
+
+    const size = written < 0x20 ? 1 : written <= 0xffff ? 3 : 5;
+    if (size !== header) {
+      this._buffer.copyWithin(
+        this._length + size,
+        this._length + header,
+        this._length + header + written,
+      );
+    }
+
+    if (size === 1) {
+      this._buffer[this._length] = 0xa0 | written;
+    } else if (size === 3) {
+      this._buffer[this._length] = 0xda;
+      this._view.setUint16(this._length + 1, written);
+    } else {
+      this._buffer[this._length] = 0xdb;
+      this._view.setUint32(this._length + 1, written);
+    }
+    this._length += size + written;
+  }
+
+  private array(value: unknown[]): void {
+    this.header(value.length, 0x90, 0xdc);
+    for (let i = 0; i < value.length; i++) {
+      if (!this.value(value[i], String(i))) {
+        this.byte(0xc0);
+      }
+    }
+  }
+
+  private object(value: Record<string, unknown>): void {
+    // Members JSON would drop are only known once packed, so the header is
+    // patched afterwards
+    const keys = Object.keys(value);
+    const start = this._length;
+    this.header(keys.length, 0x80, 0xde);
+
+    let count = 0;
+    for (const key of keys) {
+      const mark = this._length;
+      this.string(key);
+      if (this.value(value[key], key)) {
+        count++;
+      } else {
+        this._length = mark;
+      }
+    }
+
+    if (count !== keys.length) {
+      this.patch(start, keys.length, count);
+    }
+  }
+
+  private header(size: number, fixed: number, wide: number): void {
+    this.reserve(5);
+    if (size < 0x10) {
+      this._buffer[this._length++] = fixed | size;
+    } else if (size <= 0xffff) {
+      this._buffer[this._length] = wide;
+      this._view.setUint16(this._length + 1, size);
+      this._length += 3;
+    } else {
+      this._buffer[this._length] = wide + 1;
+      this._view.setUint32(this._length + 1, size);
+      this._length += 5;
+    }
+  }
+
+  /**
+   * Rewrites a map header with a smaller count, keeping its width so the
+   * members after it stay in place.
+   */
+  private patch(start: number, size: number, count: number): void {
+    if (size < 0x10) {
+      this._buffer[start] = 0x80 | count;
+    } else if (size <= 0xffff) {
+      this._view.setUint16(start + 1, count);
+    } else {
+      this._view.setUint32(start + 1, count);
+    }
+  }
+
+  private byte(value: number): void {
+    this.reserve(1);
+    this._buffer[this._length++] = value;
+  }
+
+  private reserve(size: number): void {
+    if (this._length + size <= this._buffer.length) {
+      return;
+    }
+
+    let capacity = this._buffer.length * 2;
+    while (capacity < this._length + size) {
+      capacity *= 2;
+    }
+
+    const buffer = new Uint8Array(capacity);
+    buffer.set(this._buffer.subarray(0, this._length));
+    this._buffer = buffer;
+    this._view = new DataView(buffer.buffer);
+  }
+}
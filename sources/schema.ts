@@ -7,6 +7,7 @@ import type {
   PayloadMap,
   SchemaEntry,
 } from "~/sources/types.ts";
+import { Writer } from "~/sources/writer.ts";
 
 /**
  * Represents the available constraints for a schema.
@@ -19,6 +20,7 @@ const FLAGS: AllConstraints = {
   ENUM: 1 << 4,
   REQUIRED: 1 << 5,
   VALUES: 1 << 6,
+  ADDITIONAL_PROPERTIES: 1 << 7,
 };
 
 /**
@@ -27,15 +29,21 @@ const FLAGS: AllConstraints = {
  */
 export abstract class ISchema<T extends keyof PayloadMap> {
   private _bitmap: number = 0;
+  private _sealed: boolean = false;
+  private _handles = new Map<object, Deno.PointerObject<unknown>>();
   protected _constraints: Payload<T>[] = [];
 
   /**
    * Adds a constraint to the schema.
    * @param constraint - The constraint to add.
    * @returns The instance of the schema.
-   * @throws Error if the constraint is already set.
+   * @throws Error if the constraint is already set or the schema is sealed.
    */
   protected addConstraint(constraint: Payload<T>): this {
+    if (this._sealed) {
+      throw new Error("Schema cannot be modified after being compiled");
+    }
+
     const keys = Object.keys(constraint) as Keys<
       PayloadMap[keyof PayloadMap]
     >[];
@@ -95,6 +103,92 @@ export abstract class ISchema<T extends keyof PayloadMap> {
     return pointer;
   }
 
+  /**
+   * Converts the schema to its UTF-8 bytes, without a terminator.
+   * @returns The schema as bytes.
+   */
+  public toBytes(): Uint8Array {
+    return new TextEncoder().encode(this.toString());
+  }
+
+  /**
+   * Converts the schema to its binary encoding, which the native side loads
+   * without parsing any JSON.
+   * @returns The schema as binary.
+   */
+  public toBinary(): Uint8Array {
+    const writer = new Writer();
+    this.write(writer);
+
+    return writer.finish();
+  }
+
+  /**
+   * Writes the binary encoding of the schema.
+   * @param writer - The writer of the encoding.
+   */
+  public write(writer: Writer): void {
+    writer.node(this.type, this._constraints);
+  }
+
+  /**
+   * Returns the compiled handle of the schema for the given owner, compiling
+   * it on first use. The schema and its children are sealed afterwards, as
+   * the compiled program would not observe later constraints.
+   * @param owner - The object that owns the compiled handle.
+   * @param compile - The function that compiles the binary schema.
+   * @returns The compiled handle, or `null` if the compilation failed.
+   */
+  public compile(
+    owner: object,
+    compile: (schema: Uint8Array) => Deno.PointerValue,
+  ): Deno.PointerObject<unknown> | null {
+    const cached = this._handles.get(owner);
+    if (cached !== undefined) {
+      return cached;
+    }
+
+    const handle = compile(this.toBinary());
+    if (handle === null) {
+      return null;
+    }
+
+    this.seal();
+    this._handles.set(owner, handle);
+
+    return handle;
+  }
+
+  /**
+   * Caches a handle the owner compiled some other way, sealing the schema
+   * as `compile` does.
+   * @param owner - The object that owns the compiled handle.
+   * @param handle - The compiled handle.
+   */
+  public attach(owner: object, handle: Deno.PointerObject<unknown>): void {
+    this.seal();
+    this._handles.set(owner, handle);
+  }
+
+  /**
+   * Removes the compiled handle of the given owner from the cache.
+   * @param owner - The object that owns the compiled handle.
+   * @returns The removed handle, if any.
+   */
+  public detach(owner: object): Deno.PointerObject<unknown> | undefined {
+    const handle = this._handles.get(owner);
+    this._handles.delete(owner);
+
+    return handle;
+  }
+
+  /**
+   * Prevents any further constraint from being added to the schema.
+   */
+  public seal(): void {
+    this._sealed = true;
+  }
+
   protected abstract get type(): T;
 }
 
@@ -132,9 +226,42 @@ export class ObjectSchema<T extends Record<string, ISchema<keyof PayloadMap>>>
     };
   }
 
+  /**
+   * Writes the binary encoding of the object schema, its key table and the
+   * schema of every property.
+   * @param writer - The writer of the encoding.
+   */
+  override write(writer: Writer): void {
+    super.write(writer);
+    writer.keys(Object.keys(this._data));
+    for (const value of Object.values(this._data)) {
+      value.write(writer);
+    }
+  }
+
+  /**
+   * Seals the object schema and every schema of its properties.
+   */
+  override seal(): void {
+    super.seal();
+    for (const value of Object.values(this._data)) {
+      value.seal();
+    }
+  }
+
   protected override get type(): "object" {
     return "object";
   }
+
+  /**
+   * Sets whether the object accepts keys not named by its schema. Objects
+   * are closed by default and reject unknown keys.
+   * @param allow Whether unknown keys are accepted.
+   * @returns The updated object schema.
+   */
+  additional(allow: boolean = true): this {
+    return this.addConstraint({ ADDITIONAL_PROPERTIES: allow });
+  }
 }
 
 /**
@@ -167,6 +294,24 @@ export class ArraySchema<T extends ISchema<keyof PayloadMap>> extends ISchema<
     };
   }
 
+  /**
+   * Writes the binary encoding of the array schema and the schema of its
+   * elements.
+   * @param writer - The writer of the encoding.
+   */
+  override write(writer: Writer): void {
+    super.write(writer);
+    this._data.write(writer);
+  }
+
+  /**
+   * Seals the array schema and the schema of its elements.
+   */
+  override seal(): void {
+    super.seal();
+    this._data.seal();
+  }
+
   protected override get type(): "array" {
     return "array";
   }
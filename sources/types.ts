@@ -18,6 +18,29 @@ export type SupportedOS = {
  * Represents a Blueprint object.
  * @property version - A function that returns the version of the library.
  * @property verify - A function that parses the given data using the provided schema.
+ * @property compile - A function that compiles a schema into a reusable program.
+ * @property verify_compiled - A function that verifies data against a compiled program.
+ * @property retain - A function that adds a reference to a compiled program shared between handles.
+ * @property release - A function that drops a reference to a compiled program and frees it after the last one.
+ * @property set_mode - A function that sets the validation mode.
+ * @property set_depth - A function that sets the deepest nesting a document may have.
+ * @property compile_v2 - A function that compiles a length-delimited schema into a reusable program.
+ * @property compile_plugin - A function that loads a generated validator and compiles the schema it was generated from.
+ * @property verify_v2 - A function that verifies length-delimited data and writes the verdict to an out-struct.
+ * @property verify_async - `verify_v2` run off the event loop, resolving once the verdict is written.
+ * @property verify_packed - A function that verifies a MessagePack document and writes the verdict to an out-struct.
+ * @property verify_begin - A function that starts validating a document received in chunks.
+ * @property verify_feed - A function that validates the next chunk of a document and writes the verdict to an out-struct.
+ * @property verify_end - A function that checks a chunked document is complete and writes the verdict to an out-struct.
+ * @property session_error - A function that returns the error of a chunked validation.
+ * @property session_destroy - A function that frees a chunked validation.
+ * @property verify_batch - A function that verifies many documents against a compiled program.
+ * @property batch_error - A function that returns the error of a record of the last batch.
+ * @property verify_lines - A function that verifies every record of an NDJSON buffer.
+ * @property verify_file - A function that verifies a memory-mapped file against a compiled program.
+ * @property set_threads - A function that sets the worker count of bulk validation.
+ * @property stats - A function that writes the performance counters of a handle to an out-struct.
+ * @property reset_stats - A function that clears the performance counters of a handle.
  * @param parser - A pointer to the parser to be used.
  * @param schema - A pointer to the schema to be used.
  * @param data - A pointer to the data to be parsed.
@@ -32,6 +55,182 @@ export type Blueprint = {
     data: Deno.PointerValue,
   ) => boolean;
   error: (pointer: Deno.PointerValue) => Deno.PointerValue;
+  compile: (
+    pointer: Deno.PointerValue,
+    schema: Deno.PointerValue,
+  ) => Deno.PointerValue;
+  verify_compiled: (
+    pointer: Deno.PointerValue,
+    program: Deno.PointerValue,
+    data: Deno.PointerValue,
+  ) => boolean;
+  compile_v2: (
+    pointer: Deno.PointerValue,
+    schema: BufferSource,
+    length: number | bigint,
+  ) => Deno.PointerValue;
+  compile_plugin: (
+    pointer: Deno.PointerValue,
+    path: Deno.PointerValue,
+    schema: BufferSource,
+    length: number | bigint,
+  ) => Deno.PointerValue;
+  verify_v2: (
+    pointer: Deno.PointerValue,
+    program: Deno.PointerValue,
+    data: BufferSource,
+    length: number | bigint,
+    verdict: BufferSource,
+  ) => boolean;
+  verify_async: (
+    pointer: Deno.PointerValue,
+    program: Deno.PointerValue,
+    data: BufferSource,
+    length: number | bigint,
+    verdict: BufferSource,
+  ) => Promise<boolean>;
+  verify_packed: (
+    pointer: Deno.PointerValue,
+    program: Deno.PointerValue,
+    data: BufferSource,
+    length: number | bigint,
+    verdict: BufferSource,
+  ) => boolean;
+  verify_begin: (
+    pointer: Deno.PointerValue,
+    program: Deno.PointerValue,
+  ) => Deno.PointerValue;
+  verify_feed: (
+    session: Deno.PointerValue,
+    data: BufferSource,
+    length: number | bigint,
+    verdict: BufferSource,
+  ) => boolean;
+  verify_end: (
+    session: Deno.PointerValue,
+    verdict: BufferSource,
+  ) => boolean;
+  session_error: (session: Deno.PointerValue) => Deno.PointerValue;
+  session_destroy: (session: Deno.PointerValue) => void;
+  retain: (program: Deno.PointerValue) => Deno.PointerValue;
+  release: (program: Deno.PointerValue) => void;
+  set_mode: (pointer: Deno.PointerValue, mode: number) => void;
+  set_depth: (pointer: Deno.PointerValue, depth: number) => void;
+  set_threads: (pointer: Deno.PointerValue, threads: number) => void;
+  verify_batch: (
+    pointer: Deno.PointerValue,
+    program: Deno.PointerValue,
+    documents: BufferSource,
+    lengths: BufferSource,
+    count: number | bigint,
+    results: BufferSource,
+  ) => boolean;
+  batch_error: (
+    pointer: Deno.PointerValue,
+    index: number | bigint,
+  ) => Deno.PointerValue;
+  verify_file: (
+    pointer: Deno.PointerValue,
+    program: Deno.PointerValue,
+    path: Deno.PointerValue,
+  ) => boolean;
+  verify_lines: (
+    pointer: Deno.PointerValue,
+    program: Deno.PointerValue,
+    data: BufferSource,
+    length: number | bigint,
+    report: BufferSource,
+  ) => boolean;
+  stats: (pointer: Deno.PointerValue, stats: BufferSource) => boolean;
+  reset_stats: (pointer: Deno.PointerValue) => void;
+};
+
+/**
+ * Represents the validation mode of a blueprint.
+ * `tree` builds a document before validating it, while `stream` validates
+ * the data straight from the token stream.
+ */
+export type Mode = "tree" | "stream";
+
+/**
+ * Represents the category of a validation failure.
+ * `syntax` means the record is not well-formed JSON, while `constraint`
+ * means it does not match the schema.
+ */
+export type FailureCode = "syntax" | "constraint";
+
+/**
+ * Represents a record of an NDJSON buffer that failed validation.
+ * @property record - The index of the record, blank lines excluded.
+ * @property offset - The byte offset where the record starts.
+ * @property code - The category of the failure.
+ */
+export type Failure = {
+  record: number;
+  offset: number;
+  code: FailureCode;
+};
+
+/**
+ * Represents where in the serialized input a validation failed.
+ * @property offset - The byte offset of the failing token.
+ * @property line - The line of the failing token, starting at 1.
+ * @property column - The byte column of the failing token, starting at 1.
+ */
+export type Location = {
+  offset: number;
+  line: number;
+  column: number;
+};
+
+/**
+ * Represents the outcome of an asynchronous or chunked verification.
+ * @property valid - Whether the data is valid.
+ * @property error - The error message, `null` if the data is valid.
+ * @property location - Where the serialized input failed, `null` if it
+ * passed or the failure has no position in the input.
+ */
+export type Outcome = {
+  valid: boolean;
+  error: string | null;
+  location: Location | null;
+};
+
+/**
+ * Represents the performance counters of a handle. Lexing is the time
+ * spent indexing the input, parsing and validating exclude it.
+ * @property verifications - The number of documents validated.
+ * @property bytes - The input bytes scanned.
+ * @property tokens - The tokens produced by the lexer.
+ * @property nodes - The document values built, `0` in stream mode.
+ * @property constraints - The constraint checks evaluated.
+ * @property depth - The deepest nesting seen.
+ * @property lex - The nanoseconds spent lexing.
+ * @property parse - The nanoseconds spent building documents.
+ * @property validate - The nanoseconds spent checking values.
+ */
+export type Stats = {
+  verifications: number;
+  bytes: number;
+  tokens: number;
+  nodes: number;
+  constraints: number;
+  depth: number;
+  lex: number;
+  parse: number;
+  validate: number;
+};
+
+/**
+ * Represents the outcome of validating an NDJSON buffer.
+ * @property records - The number of records found.
+ * @property valid - A bitmap where bit `i` is set when record `i` is valid.
+ * @property failures - The failed records, in input order.
+ */
+export type LinesReport = {
+  records: number;
+  valid: Uint8Array;
+  failures: Failure[];
 };
 
 /**
@@ -70,6 +269,7 @@ type InternalPayloadMap = {
   };
   object: {
     "ENUM": string[];
+    "ADDITIONAL_PROPERTIES": boolean;
   };
   array: {
     "VALUES": unknown[];
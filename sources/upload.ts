@@ -0,0 +1,139 @@
+import type { Blueprint, Location, Outcome } from "~/sources/types.ts";
+
+/**
+ * Offset reported by the native side when a failure has no input position.
+ */
+const NO_OFFSET = 0xffffffffffffffffn;
+
+/**
+ * Reads the location of a failure from a verdict.
+ * @param verdict - The verdict of a failed call.
+ * @returns The location, or `null` if the failure has no position.
+ */
+export function toLocation(verdict: BigUint64Array): Location | null {
+  if (verdict[1] === NO_OFFSET) {
+    return null;
+  }
+
+  return {
+    offset: Number(verdict[1]),
+    line: Number(verdict[2]),
+    column: Number(verdict[3]),
+  };
+}
+
+/**
+ * Verification of one document received in chunks, started by `begin`.
+ * Every chunk is validated as soon as it is fed, and only a token cut by
+ * the end of a chunk is kept until the next one, so the document is never
+ * buffered whole. Once a chunk fails, the rest of the document can be
+ * dropped.
+ *
+ * @example
+ * ```ts
+ * using upload = handle.begin(schema);
+ * for await (const chunk of request.body!) {
+ *   if (!upload.feed(chunk)) {
+ *     break;
+ *   }
+ * }
+ *
+ * const { valid, error } = upload.end();
+ * ```
+ */
+export class Upload implements Disposable {
+  private _handle: Blueprint;
+  private _session: Deno.PointerObject<unknown> | null;
+  private _close: () => void;
+  private _verdict = new BigUint64Array(4);
+  private _valid = true;
+
+  /**
+   * Wraps a native session, which is freed when the upload is disposed.
+   * @param handle - The library the session comes from.
+   * @param session - The native session.
+   * @param close - Called once the session is freed.
+   */
+  constructor(
+    handle: Blueprint,
+    session: Deno.PointerObject<unknown>,
+    close: () => void,
+  ) {
+    this._handle = handle;
+    this._session = session;
+    this._close = close;
+  }
+
+  /**
+   * Validates the next chunk of the document. The chunk is not kept, so
+   * its buffer can be reused as soon as the call returns.
+   * @param chunk - The next bytes of the document.
+   * @returns Whether the document is still valid.
+   */
+  feed(chunk: Uint8Array): boolean {
+    if (!this._valid) {
+      return false;
+    }
+
+    this._valid = this._handle.verify_feed(
+      this.session(),
+      chunk,
+      chunk.length,
+      this._verdict,
+    );
+
+    return this._valid;
+  }
+
+  /**
+   * Checks that the document is complete, after its last chunk.
+   * @returns The outcome of the verification.
+   */
+  end(): Outcome {
+    const session = this.session();
+    if (this._valid) {
+      this._valid = this._handle.verify_end(session, this._verdict);
+    }
+
+    if (this._valid) {
+      return { valid: true, error: null, location: null };
+    }
+
+    const error = this._handle.session_error(session);
+    if (error === null) {
+      throw new Error("Failed to get error message");
+    }
+
+    return {
+      valid: false,
+      error: new Deno.UnsafePointerView(error).getCString(),
+      location: toLocation(this._verdict),
+    };
+  }
+
+  /**
+   * Gets whether every chunk fed so far is valid.
+   * @returns `false` once a chunk failed.
+   */
+  public get valid(): boolean {
+    return this._valid;
+  }
+
+  [Symbol.dispose]() {
+    if (this._session === null) {
+      return;
+    }
+
+    this._handle.session_destroy(this._session);
+    this._session = null;
+    this._close();
+  }
+
+  private session(): Deno.PointerObject<unknown> {
+    if (this._session === null) {
+      throw new Error("Upload has been disposed");
+    }
+
+    return this._session;
+  }
+}
@@ -0,0 +1,228 @@
+/**
+ * Version of the binary schema encoding, read back by the native loader.
+ */
+const VERSION = 1;
+
+/**
+ * Tags ahead of every operand of a binary schema.
+ */
+const TAGS = {
+  INTEGER: 0,
+  REAL: 1,
+  STRING: 2,
+  FALSE: 3,
+  TRUE: 4,
+  NULL: 5,
+  LIST: 6,
+} as const;
+
+/**
+ * Type tags of a binary schema, in the order of the native kinds.
+ */
+const TYPES = {
+  number: 0,
+  string: 1,
+  boolean: 2,
+  null: 3,
+  array: 4,
+  object: 5,
+} as const;
+
+/**
+ * Constraint tags of a binary schema, in the order of the constraint flags.
+ */
+const CONSTRAINTS: Record<string, number> = {
+  MIN_VALUE: 0,
+  MAX_VALUE: 1,
+  MIN_LENGTH: 2,
+  MAX_LENGTH: 3,
+  ENUM: 4,
+  REQUIRED: 5,
+  VALUES: 6,
+  ADDITIONAL_PROPERTIES: 7,
+};
+
+/**
+ * Largest integer whose zigzag encoding is still exact as a number.
+ */
+const EXACT = 2 ** 52;
+
+/**
+ * Characters JSON.stringify escapes inside a string.
+ */
+const ESCAPED = /["\\\u0000-\u001f\ud800-\udfff]/;
+
+/**
+ * Returns a string as it appears between the quotes of its JSON form.
+ * @param value - The string to escape.
+ * @returns The escaped string, the same one when nothing needs escaping.
+ */
+export function escape(value: string): string {
+  return ESCAPED.test(value) ? JSON.stringify(value).slice(1, -1) : value;
+}
+
+/**
+ * Writes the binary encoding of a schema into a growable buffer. A schema
+ * starts with a zero byte, which never starts a JSON text, and the version.
+ * Integers are zigzag varints, reals little-endian doubles, and strings
+ * and lists are prefixed with their varint length. Strings are written as
+ * they appear inside JSON text, since the native side never unescapes and
+ * compares them with the raw input.
+ */
+export class Writer {
+  private _buffer = new Uint8Array(256);
+  private _view = new DataView(this._buffer.buffer);
+  private _length = 0;
+  private static _encoder = new TextEncoder();
+
+  /**
+   * Creates a writer holding the header of a binary schema.
+   */
+  constructor() {
+    this.byte(0);
+    this.byte(VERSION);
+  }
+
+  /**
+   * Writes the header of a schema node.
+   * @param type - The type of the node.
+   * @param constraints - The constraints of the node.
+   * @returns The writer.
+   */
+  public node(
+    type: keyof typeof TYPES,
+    constraints: readonly object[],
+  ): this {
+    let count = 0;
+    for (const constraint of constraints) {
+      count += Object.keys(constraint).length;
+    }
+
+    this.byte(TYPES[type]);
+    this.varint(count);
+    for (const constraint of constraints) {
+      for (const [key, value] of Object.entries(constraint)) {
+        const tag = CONSTRAINTS[key];
+        if (tag === undefined) {
+          throw new Error(`Unknown constraint ${key}`);
+        }
+
+        this.byte(tag);
+        this.literal(value, true);
+      }
+    }
+
+    return this;
+  }
+
+  /**
+   * Writes the key table of an object node.
+   * @param keys - The keys of the object, in the order of its fields.
+   * @returns The writer.
+   */
+  public keys(keys: readonly string[]): this {
+    this.varint(keys.length);
+    for (const key of keys) {
+      this.string(key);
+    }
+
+    return this;
+  }
+
+  /**
+   * Returns the bytes written so far, without copying them.
+   * @returns The binary schema.
+   */
+  public finish(): Uint8Array {
+    return this._buffer.subarray(0, this._length);
+  }
+
+  private literal(value: unknown, list: boolean): void {
+    if (typeof value === "number") {
+      if (Number.isInteger(value) && Math.abs(value) <= EXACT) {
+        this.byte(TAGS.INTEGER);
+        this.varint(value < 0 ? -2 * value - 1 : 2 * value);
+      } else {
+        this.byte(TAGS.REAL);
+        this.reserve(8);
+        this._view.setFloat64(this._length, value, true);
+        this._length += 8;
+      }
+    } else if (typeof value === "string") {
+      this.byte(TAGS.STRING);
+      this.string(value);
+    } else if (typeof value === "boolean") {
+      this.byte(value ? TAGS.TRUE : TAGS.FALSE);
+    } else if (value === null) {
+      this.byte(TAGS.NULL);
+    } else if (list && Array.isArray(value)) {
+      this.byte(TAGS.LIST);
+      this.varint(value.length);
+      for (const member of value) {
+        this.literal(member, false);
+      }
+    } else {
+      throw new Error(`Cannot encode operand ${String(value)}`);
+    }
+  }
+
+  private string(value: string): void {
+    value = escape(value);
+
+    // Every UTF-16 unit takes at most three bytes
+    this.reserve(10 + value.length * 3);
+    const start = this._length + this.size(value.length * 3);
+    const { written } = Writer._encoder.encodeInto(
+      value,
+      this._buffer.subarray(start),
+    );
+
+    // The length prefix was sized for the worst case, shrink it if needed
+    const size = this.size(written);
+    if (start - this._length !== size) {
+      this._buffer.copyWithin(this._length + size, start, start + written);
+    }
+    this.varint(written);
+    this._length += written;
+  }
+
+  private varint(value: number): void {
+    this.reserve(10);
+    while (value >= 0x80) {
+      this._buffer[this._length++] = (value % 0x80) | 0x80;
+      value = Math.floor(value / 0x80);
+    }
+    this._buffer[this._length++] = value;
+  }
+
+  private size(value: number): number {
+    let size = 1;
+    while (value >= 0x80) {
+      value = Math.floor(value / 0x80);
+      size++;
+    }
+
+    return size;
+  }
+
+  private byte(value: number): void {
+    this.reserve(1);
+    this._buffer[this._length++] = value;
+  }
+
+  private reserve(size: number): void {
+    if (this._length + size <= this._buffer.length) {
+      return;
+    }
+
+    let capacity = this._buffer.length * 2;
+    while (capacity < this._length + size) {
+      capacity *= 2;
+    }
+
+    const buffer = new Uint8Array(capacity);
+    buffer.set(this._buffer.subarray(0, this._length));
+    this._buffer = buffer;
+    this._view = new DataView(buffer.buffer);
+  }
+}
@@ -0,0 +1,35 @@
+import { assertEquals, assertStringIncludes } from "@std/assert";
+import { b } from "~/sources/mod.ts";
+
+Deno.test("async verifications in flight together", async () => {
+  using handle = await b.init();
+  handle.threads = 2;
+  const schema = b.array(b.object({ age: b.number().min(18) }));
+
+  const outcomes = await Promise.all(
+    Array.from(
+      { length: 8 },
+      (_, i) => handle.verifyAsync(schema, [{ age: 20 }, { age: 15 + i }]),
+    ),
+  );
+
+  outcomes.forEach((outcome, i) => {
+    assertEquals(outcome.valid, 15 + i >= 18);
+    if (!outcome.valid) {
+      assertStringIncludes(outcome.error ?? "", "at /1/age");
+    }
+  });
+});
+
+Deno.test("async verification reports where it failed", async () => {
+  using handle = await b.init();
+  const schema = b.object({ name: b.string().max(2) });
+
+  for (const mode of ["tree", "stream"] as const) {
+    handle.mode = mode;
+    const outcome = await handle.verifyAsync(schema, { name: "long" });
+    assertEquals(outcome.valid, false);
+    assertEquals(outcome.location, { offset: 8, line: 1, column: 9 });
+    assertEquals(handle.error, null);
+  }
+});
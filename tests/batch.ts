@@ -0,0 +1,52 @@
+import { assertEquals, assertThrows } from "@std/assert";
+import { b, type InferSchema } from "~/sources/mod.ts";
+
+Deno.test("batch of valid items", async () => {
+  using handle = await b.init();
+  const schema = b.object({ age: b.number().min(18) });
+  const items: InferSchema<typeof schema>[] = [{ age: 18 }, { age: 42 }];
+
+  assertEquals(handle.verifyMany(schema, items), [true, true]);
+  assertEquals(handle.errors, [null, null]);
+});
+
+Deno.test("batch with invalid items", async () => {
+  using handle = await b.init();
+  const schema = b.array(b.string().max(3));
+  const items: InferSchema<typeof schema>[] = [["a"], ["long"], [], ["abc"]];
+  const result = handle.verifyMany(schema, items);
+
+  assertEquals(result, [true, false, true, true]);
+  assertEquals(handle.errors[0], null);
+  assertEquals(typeof handle.errors[1], "string");
+});
+
+Deno.test("empty batch", async () => {
+  using handle = await b.init();
+  const schema = b.number();
+
+  assertEquals(handle.verifyMany(schema, []), []);
+});
+
+Deno.test("batch across threads keeps input order", async () => {
+  using handle = await b.init();
+  handle.threads = 4;
+  const schema = b.number().max(10);
+  const items = Array.from({ length: 1000 }, (_, i) => i % 20);
+  const result = handle.verifyMany(schema, items);
+
+  assertEquals(result, items.map((item) => item <= 10));
+});
+
+Deno.test("thread counts are bounded", async () => {
+  using handle = await b.init();
+  assertThrows(() => handle.threads = 2 ** 32, Error, "Invalid thread count");
+  assertEquals(handle.threads, 0);
+
+  // Spawns a few workers per core, not a million
+  handle.threads = 1_000_000;
+  const schema = b.number().max(10);
+  const items = Array.from({ length: 1000 }, (_, i) => i % 20);
+
+  assertEquals(handle.verifyMany(schema, items), items.map((i) => i <= 10));
+});
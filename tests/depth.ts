@@ -0,0 +1,67 @@
+import {
+  assertEquals,
+  assertStringIncludes,
+  assertThrows,
+} from "@std/assert";
+import { b } from "~/sources/mod.ts";
+
+Deno.test("documents deeper than the limit are rejected", async () => {
+  using handle = await b.init();
+  const schema = b.array(b.array(b.array(b.number())));
+  const data = [[[1], []], [[2, 3]]];
+
+  assertEquals(handle.depth, 1024);
+  assertEquals(handle.verify(schema, data), true);
+
+  handle.depth = 2;
+  assertEquals(handle.verify(schema, data), false);
+  assertStringIncludes(handle.error ?? "", "Nesting deeper than 2 levels");
+  assertEquals(handle.verifyPacked(schema, data), false);
+
+  handle.mode = "stream";
+  assertEquals(handle.verify(schema, data), false);
+  assertStringIncludes(handle.error ?? "", "Nesting deeper than 2 levels");
+
+  using upload = handle.begin(schema);
+  assertEquals(upload.feed(new TextEncoder().encode("[[[1]]]")), false);
+
+  handle.depth = 3;
+  assertEquals(handle.verify(schema, data), true);
+});
+
+Deno.test("deep unknown members are rejected", async () => {
+  using handle = await b.init();
+  const schema = b.object({}).additional();
+  let nested: unknown = 1;
+  for (let i = 0; i < 2000; i++) {
+    nested = [nested];
+  }
+
+  // Only checked for syntax, but still bounded
+  const data = { nested };
+  assertEquals(handle.verify(schema, data), false);
+  assertStringIncludes(handle.error ?? "", "Nesting deeper than 1024 levels");
+
+  handle.depth = 0;
+  assertEquals(handle.verify(schema, data), true);
+});
+
+Deno.test("schemas deeper than the limit are rejected", async () => {
+  using handle = await b.init();
+  const depth = 100_000;
+  const json = '{"type":"array","constraints":[],"data":'.repeat(depth) +
+    '{"type":"number","constraints":[]}' + "}".repeat(depth);
+
+  // Lowered without recursion, whatever the limit
+  const schema = b.array(b.number());
+  schema.toBinary = () => new TextEncoder().encode(json);
+
+  assertThrows(
+    () => handle.verify(schema, [1]),
+    Error,
+    "Schema nested deeper than 1024 levels",
+  );
+
+  handle.depth = 0;
+  assertEquals(handle.verify(schema, [1]), false);
+});
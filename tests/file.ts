@@ -0,0 +1,54 @@
+import { assertEquals } from "@std/assert";
+import { b } from "~/sources/mod.ts";
+
+Deno.test("file with valid data", async () => {
+  using handle = await b.init();
+  const schema = b.object({ age: b.number().min(18) });
+  const path = await Deno.makeTempFile({ suffix: ".json" });
+  await Deno.writeTextFile(path, '{"age":42}');
+
+  assertEquals(handle.verifyFile(schema, path), true);
+  assertEquals(handle.error, null);
+  await Deno.remove(path);
+});
+
+Deno.test("file with invalid data", async () => {
+  using handle = await b.init();
+  const schema = b.object({ age: b.number().min(18) });
+  const path = await Deno.makeTempFile({ suffix: ".json" });
+  await Deno.writeTextFile(path, '{"age":12}');
+
+  assertEquals(handle.verifyFile(schema, path), false);
+  await Deno.remove(path);
+});
+
+Deno.test("missing file", async () => {
+  using handle = await b.init();
+  const schema = b.number();
+
+  assertEquals(handle.verifyFile(schema, "/nonexistent/blueprint.json"), false);
+  assertEquals(typeof handle.error, "string");
+});
+
+Deno.test("large file in the default mode", async () => {
+  using handle = await b.init();
+  const schema = b.array(b.number().max(100000));
+  const path = await Deno.makeTempFile({ suffix: ".json" });
+  const values = Array.from({ length: 2_000_000 }, (_, i) => i % 100000);
+  await Deno.writeTextFile(path, JSON.stringify(values));
+
+  const before = Deno.memoryUsage().rss;
+  assertEquals(handle.mode, "tree");
+  assertEquals(handle.verifyFile(schema, path), true);
+  assertEquals(handle.mode, "tree");
+
+  // A tree of the file would take several times its 12 MB
+  const growth = Deno.memoryUsage().rss - before;
+  assertEquals(growth < 64 * 1024 * 1024, true);
+
+  const stats = handle.stats;
+  if (stats !== null) {
+    assertEquals(stats.nodes, 0);
+  }
+  await Deno.remove(path);
+});
@@ -0,0 +1,26 @@
+import { assertEquals } from "@std/assert";
+import { b } from "~/sources/mod.ts";
+
+Deno.test("ndjson with valid records", async () => {
+  using handle = await b.init();
+  const schema = b.object({ age: b.number().min(18) });
+  const report = handle.verifyLines(schema, '{"age":18}\n{"age":42}\n');
+
+  assertEquals(report.records, 2);
+  assertEquals(report.valid, new Uint8Array([0b11]));
+  assertEquals(report.failures, []);
+});
+
+Deno.test("ndjson with invalid records", async () => {
+  using handle = await b.init();
+  const schema = b.object({ age: b.number().min(18) });
+  const data = '{"age":21}\n\n{"age":12}\n{"age":\n{"age":30}';
+  const report = handle.verifyLines(schema, data);
+
+  assertEquals(report.records, 4);
+  assertEquals(report.valid, new Uint8Array([0b1001]));
+  assertEquals(report.failures, [
+    { record: 1, offset: 12, code: "constraint" },
+    { record: 2, offset: 23, code: "syntax" },
+  ]);
+});
@@ -1,4 +1,4 @@
-import { assertEquals } from "@std/assert";
+import { assertEquals, assertStringIncludes } from "@std/assert";
 import { b, type InferSchema } from "~/sources/mod.ts";
 
 Deno.test("empty object", async () => {
@@ -148,3 +148,39 @@ Deno.test("object with deeply nested object and array", async () => {
 
   assertEquals(result, true);
 });
+
+Deno.test("object with unknown key", async () => {
+  using handle = await b.init();
+  const schema = b.object({ name: b.string() });
+  const data = { name: "a", extra: 1 };
+  const result = handle.verify(schema, data);
+
+  assertEquals(result, false);
+});
+
+Deno.test("object with additional properties", async () => {
+  using handle = await b.init();
+  const schema = b.object({ name: b.string().max(3) }).additional();
+  const data = { name: "a", extra: { nested: [1, 2, 3] } };
+
+  assertEquals(handle.verify(schema, data), true);
+  handle.mode = "stream";
+  assertEquals(handle.verify(schema, data), true);
+  assertEquals(handle.verify(schema, { ...data, name: "long" }), false);
+});
+
+Deno.test("object error names the failing path", async () => {
+  using handle = await b.init();
+  const schema = b.object({
+    users: b.array(b.object({ age: b.number().min(18) })),
+  });
+  const data = { users: [{ age: 20 }, { age: 12 }] };
+
+  assertEquals(handle.verify(schema, data), false);
+  assertStringIncludes(handle.error ?? "", "at /users/1/age");
+  assertEquals(handle.location, { offset: 28, line: 1, column: 29 });
+  handle.mode = "stream";
+  assertEquals(handle.verify(schema, data), false);
+  assertStringIncludes(handle.error ?? "", "at /users/1/age");
+  assertEquals(handle.location, { offset: 28, line: 1, column: 29 });
+});
@@ -0,0 +1,86 @@
+import { assertEquals, assertStringIncludes } from "@std/assert";
+import { b } from "~/sources/mod.ts";
+
+Deno.test("packed data matches its JSON verdict", async () => {
+  using handle = await b.init();
+  const schema = b.object({
+    id: b.number().min(0).max(2 ** 60),
+    name: b.string().max(8).enum(["a\"b", "plain"]),
+    tags: b.array(b.string()).max(2),
+  });
+
+  const items = [
+    { id: 2 ** 60, name: 'a"b', tags: ["x"] },
+    { id: 1.5, name: "plain", tags: [] },
+    { id: -1, name: "plain", tags: [] },
+    { id: 1, name: "other", tags: [] },
+    { id: 1, name: "plain", tags: ["x", "y", "z"] },
+  ];
+  for (const item of items) {
+    assertEquals(
+      handle.verifyPacked(schema, item),
+      handle.verify(schema, item),
+    );
+  }
+});
+
+Deno.test("packed data names the failing path", async () => {
+  using handle = await b.init();
+  const schema = b.array(b.object({ age: b.number().min(18) }));
+
+  assertEquals(handle.verifyPacked(schema, [{ age: 21 }, { age: 12 }]), false);
+  assertStringIncludes(handle.error ?? "", "at /1/age");
+  assertEquals(handle.verifyPacked(schema, [{ age: 21 }]), true);
+  assertEquals(handle.error, null);
+});
+
+Deno.test("packed strings are plain UTF-8", async () => {
+  using handle = await b.init();
+  const schema = b.object({
+    "a\nb": b.string().max(4).enum(['a"b', "é\t"]),
+  });
+
+  // {"a\nb": 'a"b'} as any MessagePack encoder writes it
+  const valid = new Uint8Array([
+    0x81,
+    0xa3,
+    0x61,
+    0x0a,
+    0x62,
+    0xa3,
+    0x61,
+    0x22,
+    0x62,
+  ]);
+  assertEquals(handle.verifyPackedBytes(schema, valid), true);
+
+  // "é\t" escapes to four bytes, within the bound
+  const tab = new Uint8Array([0x81, 0xa3, 0x61, 0x0a, 0x62, 0xa3]);
+  const text = new Uint8Array([0xc3, 0xa9, 0x09]);
+  assertEquals(
+    handle.verifyPackedBytes(schema, new Uint8Array([...tab, ...text])),
+    true,
+  );
+
+  // Escaped text is a different string once packed
+  const escaped = new Uint8Array([
+    0x81,
+    0xa3,
+    0x61,
+    0x0a,
+    0x62,
+    0xa4,
+    0x61,
+    0x5c,
+    0x22,
+    0x62,
+  ]);
+  assertEquals(handle.verifyPackedBytes(schema, escaped), false);
+
+  for (const name of ['a"b', "é\t", "a\\b", "x"]) {
+    assertEquals(
+      handle.verifyPacked(schema, { "a\nb": name }),
+      handle.verify(schema, { "a\nb": name }),
+    );
+  }
+});
@@ -0,0 +1,62 @@
+import {
+  assertEquals,
+  assertStringIncludes,
+  assertThrows,
+} from "@std/assert";
+import { b } from "~/sources/mod.ts";
+
+Deno.test("missing plugin libraries are rejected", async () => {
+  using handle = await b.init();
+  const schema = b.object({ id: b.number().min(0) });
+
+  assertThrows(
+    () => handle.plugin(schema, "./missing-plugin.so"),
+    Error,
+    "Failed to load plugin: Failed to load './missing-plugin.so'",
+  );
+
+  // The schema is still compiled the usual way
+  assertEquals(handle.verify(schema, { id: 1 }), true);
+  assertEquals(handle.verify(schema, { id: -1 }), false);
+});
+
+// Built from tests/plugin.json by the test-plugin target of a
+// -DBLUEPRINT_CODEGEN=ON build, into <build>/plugins
+const plugins = Deno.env.get("BLUEPRINT_PLUGINS");
+
+function user() {
+  return b.object({ name: b.string().min(1), age: b.number().min(18) });
+}
+
+Deno.test("plugin fixture matches its schema", async () => {
+  const fixture = await Deno.readTextFile("tests/plugin.json");
+
+  assertEquals(user().toString(), fixture.trimEnd());
+});
+
+Deno.test({
+  name: "generated plugins accept and fall back to the interpreter",
+  ignore: plugins === undefined,
+  fn: async () => {
+    using handle = await b.init();
+    const extension = Deno.build.os === "windows" ? "dll" : "so";
+    const path = `${plugins}/test-plugin.${extension}`;
+    const schema = user();
+
+    assertThrows(
+      () => handle.plugin(b.object({ age: b.number().min(21) }), path),
+      Error,
+      `Failed to load plugin: Plugin '${path}' was generated from another`,
+    );
+
+    handle.plugin(schema, path);
+    assertEquals(handle.verify(schema, { name: "a", age: 20 }), true);
+    assertEquals(handle.error, null);
+
+    // Turned down by the plugin, the interpreter gives the error
+    assertEquals(handle.verify(schema, { name: "a", age: 12 }), false);
+    assertStringIncludes(handle.error ?? "", "at /age");
+    assertEquals(handle.verify(schema, { name: "a", extra: 1 }), false);
+    assertStringIncludes(handle.error ?? "", "Unknown key 'extra'");
+  },
+});
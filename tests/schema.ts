@@ -0,0 +1,84 @@
+import { assertEquals, assertThrows } from "@std/assert";
+import { b, type InferSchema } from "~/sources/mod.ts";
+
+Deno.test("schema reused across verifications", async () => {
+  using handle = await b.init();
+  const schema = b.object({ age: b.number().min(18) });
+  const valid: InferSchema<typeof schema> = { age: 21 };
+  const invalid: InferSchema<typeof schema> = { age: 12 };
+
+  assertEquals(handle.verify(schema, valid), true);
+  assertEquals(handle.verify(schema, invalid), false);
+  assertEquals(handle.verify(schema, valid), true);
+});
+
+Deno.test("schema reused across handles", async () => {
+  const schema = b.array(b.string().max(3));
+  const data: InferSchema<typeof schema> = ["a", "bc"];
+
+  for (let i = 0; i < 2; i++) {
+    using handle = await b.init();
+    assertEquals(handle.verify(schema, data), true);
+  }
+});
+
+Deno.test("schema sealed after verification", async () => {
+  using handle = await b.init();
+  const inner = b.number();
+  const schema = b.object({ age: inner });
+  handle.verify(schema, { age: 1 });
+
+  assertThrows(() => inner.min(1));
+});
+
+Deno.test("schema compiled from its binary encoding", async () => {
+  using handle = await b.init();
+  const schema = b.object({
+    "názov": b.string().min(1).max(3).enum(["a", "bc"]),
+    ratio: b.number().min(-1.5).max(2 ** 60).values([-1.5, 7, 2 ** 60]),
+    tags: b.array(b.number()).max(2).values([1, 2]),
+  }).additional(false);
+  const binary = schema.toBinary();
+
+  assertEquals(binary.subarray(0, 3), new Uint8Array([0, 1, 5]));
+  assertEquals(
+    handle.verify(schema, { "názov": "bc", ratio: 2 ** 60, tags: [2] }),
+    true,
+  );
+  assertEquals(
+    handle.verify(schema, { "názov": "a", ratio: 6, tags: [1] }),
+    false,
+  );
+  assertEquals(
+    handle.verify(schema, { "názov": "a", ratio: 7, tags: [3] }),
+    false,
+  );
+
+  const quoted = b.object({ 'say "hi"': b.string().enum(["a\\b\n"]) });
+  assertEquals(handle.verify(quoted, { 'say "hi"': "a\\b\n" }), true);
+  assertEquals(handle.verify(quoted, { 'say "hi"': "a\\b" }), false);
+});
+
+Deno.test("schema decoded from a deeply nested binary encoding", async () => {
+  using handle = await b.init();
+  const depth = 200_000;
+  const binary = new Uint8Array(2 + depth * 2 + 2);
+  binary.set([0, 1]);
+  for (let i = 0; i < depth; i++) {
+    binary.set([4, 0], 2 + i * 2);
+  }
+
+  // Arrays nested around a number, read without recursion
+  const schema = b.array(b.number());
+  schema.toBinary = () => binary;
+
+  assertThrows(
+    () => handle.verify(schema, 1),
+    Error,
+    "Schema nested deeper than 1024 levels at byte 2050",
+  );
+
+  handle.depth = 0;
+  assertEquals(handle.verify(schema, [[[1]]]), false);
+  assertEquals(handle.verify(schema, 1), false);
+});
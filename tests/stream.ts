@@ -0,0 +1,71 @@
+import { assertEquals } from "@std/assert";
+import { b, type InferSchema } from "~/sources/mod.ts";
+
+Deno.test("stream mode with constrained objects", async () => {
+  using handle = await b.init();
+  handle.mode = "stream";
+  const schema = b.array(b.object({
+    name: b.string().min(1).max(5),
+    tags: b.array(b.string()).max(2),
+  }));
+  const data: InferSchema<typeof schema> = [
+    { name: "a", tags: ["x"] },
+    { name: "b", tags: [] },
+  ];
+  const result = handle.verify(schema, data);
+
+  assertEquals(result, true);
+});
+
+Deno.test("stream mode with constrained objects (invalid)", async () => {
+  using handle = await b.init();
+  handle.mode = "stream";
+  const schema = b.array(b.object({
+    name: b.string().min(1).max(5),
+    tags: b.array(b.string()).max(2),
+  }));
+  const data: InferSchema<typeof schema> = [
+    { name: "a", tags: ["x"] },
+    { name: "b", tags: ["x", "y", "z"] },
+  ];
+  const result = handle.verify(schema, data);
+
+  assertEquals(result, false);
+});
+
+Deno.test("stream mode with allowed values (invalid)", async () => {
+  using handle = await b.init();
+  handle.mode = "stream";
+  const schema = b.array(b.number()).values([1, 2, 3]);
+  const data: InferSchema<typeof schema> = [1, 2, 4];
+  const result = handle.verify(schema, data);
+
+  assertEquals(result, false);
+});
+
+Deno.test("stream mode reports the failing offset", async () => {
+  using handle = await b.init();
+  handle.mode = "stream";
+  const schema = b.array(b.number().max(10));
+
+  assertEquals(handle.verify(schema, [1, 20]), false);
+  assertEquals(handle.offset, 3);
+  assertEquals(handle.verify(schema, [1, 2]), true);
+  assertEquals(handle.offset, null);
+});
+
+Deno.test("stats count validations when built in", async () => {
+  using handle = await b.init();
+  const schema = b.array(b.number());
+
+  handle.verify(schema, [1, 2, 3]);
+  const stats = handle.stats;
+  if (stats === null) {
+    return;
+  }
+
+  assertEquals(stats.verifications, 1);
+  assertEquals(stats.bytes, 7);
+  handle.resetStats();
+  assertEquals(handle.stats?.verifications, 0);
+});
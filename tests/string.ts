@@ -1,4 +1,4 @@
-import { assertEquals } from "@std/assert";
+import { assertEquals, assertThrows } from "@std/assert";
 import { b, type InferSchema } from "~/sources/mod.ts";
 
 Deno.test("string with minimum length", async () => {
@@ -54,3 +54,32 @@ Deno.test("string with allowed values", async () => {
 
   assertEquals(result, true);
 });
+
+Deno.test("string with many allowed values", async () => {
+  using handle = await b.init();
+  const members = Array.from({ length: 500 }, (_, i) => `member-${i}`);
+  const schema = b.string().enum(members as [string, ...string[]]);
+
+  assertEquals(handle.verify(schema, "member-0"), true);
+  assertEquals(handle.verify(schema, "member-499"), true);
+  assertEquals(handle.verify(schema, "member-500"), false);
+});
+
+Deno.test("length bounds that are not whole sizes are rejected", async () => {
+  using handle = await b.init();
+
+  for (const bound of [1e30, 2 ** 64, 2.5, -1]) {
+    assertThrows(
+      () => handle.verify(b.string().max(bound), "ab"),
+      Error,
+      "Invalid MAX_LENGTH constraint",
+    );
+  }
+
+  assertThrows(
+    () => handle.verify(b.array(b.number()).min(0.5), []),
+    Error,
+    "Invalid MIN_LENGTH constraint",
+  );
+  assertEquals(handle.verify(b.string().max(2 ** 53), "ab"), true);
+});
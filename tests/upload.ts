@@ -0,0 +1,53 @@
+import { assertEquals, assertStringIncludes } from "@std/assert";
+import { b } from "~/sources/mod.ts";
+
+const encoder = new TextEncoder();
+
+Deno.test("chunks split inside tokens", async () => {
+  using handle = await b.init();
+  const schema = b.object({
+    name: b.string().max(16),
+    age: b.number().min(18),
+    admin: b.boolean(),
+  });
+  const text = '{"name": "Ja\\"vi", "age": 21.5e0, "admin": false}';
+
+  // Every split point, so strings, numbers and literals are all cut
+  for (let i = 1; i < text.length; i++) {
+    using upload = handle.begin(schema);
+    assertEquals(upload.feed(encoder.encode(text.slice(0, i))), true);
+    assertEquals(upload.feed(encoder.encode(text.slice(i))), true);
+    assertEquals(upload.end(), { valid: true, error: null, location: null });
+  }
+});
+
+Deno.test("chunked document rejected at the offending chunk", async () => {
+  using handle = await b.init();
+  const schema = b.array(b.number().max(10));
+  using upload = handle.begin(schema);
+
+  assertEquals(upload.feed(encoder.encode("[1,\n 2")), true);
+  assertEquals(upload.feed(encoder.encode("0, 3")), false);
+  assertEquals(upload.feed(encoder.encode("]")), false);
+
+  const outcome = upload.end();
+  assertEquals(outcome.valid, false);
+  assertStringIncludes(outcome.error ?? "", "at /1");
+  assertEquals(outcome.location, { offset: 5, line: 2, column: 2 });
+});
+
+Deno.test("document verified from a stream", async () => {
+  using handle = await b.init();
+  const schema = b.array(b.string());
+  const body = (text: string) =>
+    ReadableStream.from(
+      text.match(/.{1,3}/g)!.map((chunk) => encoder.encode(chunk)),
+    );
+
+  const valid = await handle.verifyStream(schema, body('["ab", "cd"]'));
+  assertEquals(valid.valid, true);
+
+  const truncated = await handle.verifyStream(schema, body('["ab", "c'));
+  assertEquals(truncated.valid, false);
+  assertStringIncludes(truncated.error ?? "", "Expected '\"'");
+});